@@ -0,0 +1,102 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "footprint.h"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#ifdef GOODBENCHMARK_XRES
+#include <X11/Xlib.h>
+#include <X11/extensions/XRes.h>
+#endif
+
+static qint64 heapBytes()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    const struct mallinfo2 info = mallinfo2();
+    return qint64(info.uordblks) + qint64(info.hblkhd);
+#elif defined(__GLIBC__)
+    const struct mallinfo info = mallinfo();
+    return qint64(uint(info.uordblks)) + qint64(uint(info.hblkhd));
+#else
+    return -1;
+#endif
+}
+
+FootprintSample sampleFootprint(QWidget *probe_widget)
+{
+    FootprintSample sample;
+    sample.heap_bytes = heapBytes();
+    sample.x_pixmap_bytes = -1;
+    sample.x_window_count = -1;
+    sample.x_pixmap_count = -1;
+
+#ifdef GOODBENCHMARK_XRES
+    if (!probe_widget || QGuiApplication::platformName() != "xcb")
+        return sample;
+
+    //A connection of it's own, the client is found by any resource it owns.
+    Display *dpy = XOpenDisplay(nullptr);
+
+    if (!dpy)
+        return sample;
+
+    const XID client_xid = XID(probe_widget->winId());
+
+    unsigned long pixmap_bytes = 0;
+
+    if (XResQueryClientPixmapBytes(dpy, client_xid, &pixmap_bytes))
+        sample.x_pixmap_bytes = qint64(pixmap_bytes);
+
+    int type_count = 0;
+    XResType *type_list = nullptr;
+
+    if (XResQueryClientResources(dpy, client_xid, &type_count, &type_list))
+    {
+        const Atom window_atom = XInternAtom(dpy, "WINDOW", False);
+        const Atom pixmap_atom = XInternAtom(dpy, "PIXMAP", False);
+
+        sample.x_window_count = 0;
+        sample.x_pixmap_count = 0;
+
+        for (int i = 0; i < type_count; i++)
+        {
+            if (type_list[i].resource_type == window_atom)
+                sample.x_window_count = type_list[i].count;
+            else if (type_list[i].resource_type == pixmap_atom)
+                sample.x_pixmap_count = type_list[i].count;
+        }
+
+        XFree(type_list);
+    }
+
+    XCloseDisplay(dpy);
+#else
+    Q_UNUSED(probe_widget)
+#endif
+
+    return sample;
+}
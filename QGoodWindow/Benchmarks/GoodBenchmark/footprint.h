@@ -0,0 +1,51 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FOOTPRINT_H
+#define FOOTPRINT_H
+
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+
+//Process wide memory and X server resources at one point in time,
+//values that can't be read on this platform are -1.
+struct FootprintSample
+{
+    //Bytes in use by the heap allocator.
+    qint64 heap_bytes;
+
+    //Bytes of the pixmaps this client owns on the X server.
+    qint64 x_pixmap_bytes;
+
+    //Number of windows and pixmaps this client owns on the X server.
+    qint64 x_window_count;
+    qint64 x_pixmap_count;
+};
+
+//Reads the heap usage from the C library and the server side resources of
+//the client owning probe_widget from the XRes extension.
+FootprintSample sampleFootprint(QWidget *probe_widget);
+
+#endif // FOOTPRINT_H
@@ -0,0 +1,1712 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+#include <QGoodWindow>
+#include <QGoodCentralWidget>
+#include <src/qgoodimagefilter.h>
+#ifdef QGOODWINDOW
+#include <src/titlebarlayout.h>
+#endif
+#include "footprint.h"
+
+class BenchmarkWindow : public QGoodWindow
+{
+public:
+    explicit BenchmarkWindow(int child_count, QWidget *parent = nullptr) : QGoodWindow(parent)
+    {
+        m_good_central_widget = new QGoodCentralWidget(this);
+
+        //A central widget with many children, so any restyle of the
+        //window subtree has a measurable cost.
+        QWidget *central_widget = new QWidget(m_good_central_widget);
+
+        QGridLayout *layout = new QGridLayout(central_widget);
+
+        for (int i = 0; i < child_count; i++)
+        {
+            if (i % 2 == 0)
+                layout->addWidget(new QLabel(QString("Label %0").arg(i), central_widget), i / 4, i % 4);
+            else
+                layout->addWidget(new QPushButton(QString("Button %0").arg(i), central_widget), i / 4, i % 4);
+        }
+
+        m_good_central_widget->setCentralWidget(central_widget);
+
+        setCentralWidget(m_good_central_widget);
+
+        setWindowTitle("GoodBenchmark");
+    }
+
+    QGoodCentralWidget *m_good_central_widget;
+};
+
+class PaintCounter : public QObject
+{
+public:
+    explicit PaintCounter(const char *class_name) : QObject()
+    {
+        m_class_name = class_name;
+        m_count = 0;
+    }
+
+    bool eventFilter(QObject *watched, QEvent *event)
+    {
+        if (event->type() == QEvent::Paint && watched->inherits(m_class_name))
+            m_count++;
+
+        return QObject::eventFilter(watched, event);
+    }
+
+    const char *m_class_name;
+    int m_count;
+};
+
+//Records the time from a reference point to the first paint of a dialog
+//and closes the dialog right after.
+class FirstPaintWatcher : public QObject
+{
+public:
+    explicit FirstPaintWatcher(QDialog *dialog, QElapsedTimer *timer) : QObject(dialog)
+    {
+        m_dialog = dialog;
+        m_timer = timer;
+        m_elapsed_ns = -1;
+
+        m_dialog->installEventFilter(this);
+    }
+
+    bool eventFilter(QObject *watched, QEvent *event)
+    {
+        if (event->type() == QEvent::Paint && watched == m_dialog && m_elapsed_ns < 0)
+        {
+            m_elapsed_ns = m_timer->nsecsElapsed();
+            QTimer::singleShot(0, m_dialog, &QDialog::accept);
+        }
+
+        return QObject::eventFilter(watched, event);
+    }
+
+    QDialog *m_dialog;
+    QElapsedTimer *m_timer;
+    qint64 m_elapsed_ns;
+};
+
+//Counts the geometry changes a dialog window receives after it's shown,
+//every one of them is a configure round trip with the window manager.
+//Records the time from a reference point to the first paint of a widget.
+class WidgetFirstPaintWatcher : public QObject
+{
+public:
+    explicit WidgetFirstPaintWatcher(QWidget *widget, QElapsedTimer *timer) : QObject(widget)
+    {
+        m_widget = widget;
+        m_timer = timer;
+        m_elapsed_ns = -1;
+
+        m_widget->installEventFilter(this);
+    }
+
+    bool eventFilter(QObject *watched, QEvent *event)
+    {
+        if (event->type() == QEvent::Paint && watched == m_widget && m_elapsed_ns < 0)
+            m_elapsed_ns = m_timer->nsecsElapsed();
+
+        return QObject::eventFilter(watched, event);
+    }
+
+    QWidget *m_widget;
+    QElapsedTimer *m_timer;
+    qint64 m_elapsed_ns;
+};
+
+class ConfigureCounter : public QObject
+{
+public:
+    explicit ConfigureCounter(QDialog *dialog) : QObject(dialog)
+    {
+        m_dialog = dialog;
+        m_window = nullptr;
+        m_window_shown = false;
+        m_close_scheduled = false;
+        m_resize_count = 0;
+        m_move_count = 0;
+
+        m_dialog->installEventFilter(this);
+    }
+
+    bool eventFilter(QObject *watched, QEvent *event)
+    {
+        if (watched == m_dialog && event->type() == QEvent::Show && !m_window)
+        {
+            //The dialog is shown as a child of its window, right before the window itself.
+            m_window = m_dialog->window();
+            m_window->installEventFilter(this);
+        }
+        else if (watched == m_dialog && event->type() == QEvent::Paint && m_window_shown && !m_close_scheduled)
+        {
+            //Give late configure events some time to arrive before closing.
+            m_close_scheduled = true;
+            QTimer::singleShot(200, m_dialog, &QDialog::accept);
+        }
+        else if (watched == m_window)
+        {
+            switch (event->type())
+            {
+            case QEvent::Show:
+                m_window_shown = true;
+                break;
+            case QEvent::Resize:
+                if (m_window_shown)
+                    m_resize_count++;
+                break;
+            case QEvent::Move:
+                if (m_window_shown)
+                    m_move_count++;
+                break;
+            default:
+                break;
+            }
+        }
+
+        return QObject::eventFilter(watched, event);
+    }
+
+    QDialog *m_dialog;
+    QWidget *m_window;
+    bool m_window_shown;
+    bool m_close_scheduled;
+    int m_resize_count;
+    int m_move_count;
+};
+
+//Results of the run, written with --json.
+static QJsonObject json_results;
+
+static void printResult(const QString &name, int iterations, qint64 elapsed_ns)
+{
+    const double total_ms = double(elapsed_ns) / 1000000.0;
+    const double per_iteration_us = double(elapsed_ns) / 1000.0 / qMax(iterations, 1);
+
+    QTextStream out(stdout);
+    out << name << ": " << iterations << " iterations, "
+        << QString::number(total_ms, 'f', 3) << " ms total, "
+        << QString::number(per_iteration_us, 'f', 3) << " us/iteration\n";
+
+    QJsonObject result;
+    result.insert("iterations", iterations);
+    result.insert("total_ms", total_ms);
+    result.insert("per_iteration_us", per_iteration_us);
+
+    json_results.insert(name, result);
+}
+
+static void printValue(const QString &name, double value, const QString &unit)
+{
+    QTextStream(stdout) << name << ": " << QString::number(value, 'f', 1) << " " << unit << "\n";
+
+    QJsonObject result;
+    result.insert("value", value);
+    result.insert("unit", unit);
+
+    json_results.insert(name, result);
+}
+
+static void waitForEvents(int msecs)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while (timer.elapsed() < msecs)
+        qApp->processEvents(QEventLoop::AllEvents, 10);
+}
+
+//Create and destroy windows with QGoodCentralWidget, hidden and shown.
+static void benchmarkConstructDestroy(int iterations)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        BenchmarkWindow *window = new BenchmarkWindow(0);
+        delete window;
+    }
+
+    printResult("construct_destroy", iterations, timer.nsecsElapsed());
+
+    const int count = qMax(iterations / 10, 1);
+
+    timer.start();
+
+    for (int i = 0; i < count; i++)
+    {
+        BenchmarkWindow *window = new BenchmarkWindow(0);
+        window->resize(640, 480);
+        window->show();
+        qApp->processEvents();
+        delete window;
+    }
+
+    printResult("construct_show_destroy", count, timer.nsecsElapsed());
+}
+
+//Resize a window in 1000 small steps, as an interactive resize does.
+static void benchmarkResizeStorm()
+{
+    const int steps = 1000;
+
+    BenchmarkWindow *window = new BenchmarkWindow(0);
+    window->resize(640, 480);
+    window->show();
+
+    waitForEvents(200);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < steps; i++)
+    {
+        //Grow for half of the steps and shrink back for the other half.
+        const int delta = (i < steps / 2) ? i : (steps - i);
+
+        window->resize(640 + delta, 480 + delta / 2);
+        qApp->processEvents();
+    }
+
+    printResult("resize_storm", steps, timer.nsecsElapsed());
+
+    delete window;
+}
+
+//Cycle a window through maximized, normal, full screen and normal.
+static void benchmarkStateToggle(int iterations)
+{
+    BenchmarkWindow *window = new BenchmarkWindow(0);
+    window->resize(640, 480);
+    window->show();
+
+    waitForEvents(200);
+
+    const int count = qMax(iterations / 10, 1);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < count; i++)
+    {
+        window->showMaximized();
+        qApp->processEvents();
+        window->showNormal();
+        qApp->processEvents();
+        window->showFullScreen();
+        qApp->processEvents();
+        window->showNormal();
+        qApp->processEvents();
+    }
+
+    printResult("state_toggle", count * 4, timer.nsecsElapsed());
+
+    delete window;
+}
+
+//Change the title every 16 ms, as a progress indicator would, and measure
+//only the time spent handling each change.
+static void benchmarkTitleUpdates60Hz(int iterations)
+{
+    BenchmarkWindow *window = new BenchmarkWindow(0);
+    window->resize(640, 480);
+    window->show();
+
+    waitForEvents(200);
+
+    const qint64 frame_ns = 1000000000 / 60;
+
+    qint64 busy_ns = 0;
+
+    QElapsedTimer clock;
+    clock.start();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        while (clock.nsecsElapsed() < frame_ns * i)
+            qApp->processEvents(QEventLoop::AllEvents, 1);
+
+        QElapsedTimer timer;
+        timer.start();
+
+        window->setWindowTitle(QString("GoodBenchmark - %0%").arg(i % 101));
+        qApp->processEvents();
+
+        busy_ns += timer.nsecsElapsed();
+    }
+
+    printResult("title_update_60hz", iterations, busy_ns);
+
+    delete window;
+}
+
+//Send a synthetic mouse move to the widget, at a position in its coordinates.
+static void sendMouseMove(QWidget *target, const QPoint &pos)
+{
+    QMouseEvent event(QEvent::MouseMove, QPointF(pos), QPointF(target->mapToGlobal(pos)),
+                      Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+    QApplication::sendEvent(target, &event);
+}
+
+//Sample positions covering the resize borders, the caption and its buttons
+//and the client area of a window with the given size.
+static QList<QPoint> hitTestGrid(const QSize &size)
+{
+    QList<int> x_list;
+
+    for (int x = 0; x < 9; x++)
+        x_list.append(x);
+
+    for (int x = 16; x < size.width() - 9; x += 16)
+        x_list.append(x);
+
+    for (int x = qMax(9, size.width() - 9); x < size.width(); x++)
+        x_list.append(x);
+
+    QList<int> y_list;
+
+    for (int y = 0; y < 9; y++)
+        y_list.append(y);
+
+    for (int y = 12; y < qMin(44, size.height() - 9); y += 4)
+        y_list.append(y);
+
+    for (int y = 64; y < size.height() - 9; y += 32)
+        y_list.append(y);
+
+    for (int y = qMax(9, size.height() - 9); y < size.height(); y++)
+        y_list.append(y);
+
+    QList<QPoint> grid;
+
+    for (int y : y_list)
+    {
+        for (int x : x_list)
+            grid.append(QPoint(x, y));
+    }
+
+    return grid;
+}
+
+//Hit test a grid of cursor positions over the window. QGoodWindow hit tests
+//the real cursor position, so the cursor is moved to every sample before the
+//mouse move reaches the window.
+static void benchmarkHitTest(int iterations)
+{
+    BenchmarkWindow *window = new BenchmarkWindow(0);
+    window->resize(640, 480);
+    window->show();
+
+    waitForEvents(200);
+
+    QWidget *target = window->m_good_central_widget;
+
+    //Event dispatch cost only: synthetic moves while the cursor stays put,
+    //every one of them is hit tested at the same position.
+    const int count = iterations * 100;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < count; i++)
+        sendMouseMove(target, QPoint(i % target->width(), (i / 7) % target->height()));
+
+    printResult("hit_test_event_dispatch", count, timer.nsecsElapsed());
+
+    const QList<QPoint> grid = hitTestGrid(window->size());
+
+    const QGoodWindowStats stats_before = window->stats();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        for (const QPoint &pos : grid)
+        {
+            QCursor::setPos(window->mapToGlobal(pos));
+            sendMouseMove(target, target->mapFrom(window, pos));
+            qApp->processEvents();
+        }
+    }
+
+    const QGoodWindowStats stats = window->stats();
+
+    const quint64 hit_tests = stats.count(QGoodWindowStats::Counter::HitTest) -
+            stats_before.count(QGoodWindowStats::Counter::HitTest);
+
+    if (hit_tests > 0)
+    {
+        const qint64 hit_test_ns = stats.nsecs(QGoodWindowStats::Counter::HitTest) -
+                stats_before.nsecs(QGoodWindowStats::Counter::HitTest);
+
+        printResult("hit_test", int(hit_tests), hit_test_ns);
+    }
+
+    delete window;
+}
+
+//Resize and activate/deactivate windows, each step triggers a full
+//QGoodCentralWidget update of the title bar and borders.
+static void benchmarkResizeActivate(int window_count, int child_count, int iterations)
+{
+    QList<BenchmarkWindow*> window_list;
+
+    for (int i = 0; i < window_count; i++)
+    {
+        BenchmarkWindow *window = new BenchmarkWindow(child_count);
+        window->resize(640, 480);
+        window->show();
+        window_list.append(window);
+    }
+
+    //Let the windows settle before measuring.
+    QElapsedTimer settle_timer;
+    settle_timer.start();
+
+    while (settle_timer.elapsed() < 500)
+        qApp->processEvents(QEventLoop::AllEvents, 50);
+
+    int passes_before = 0;
+    int requests_before = 0;
+
+    for (BenchmarkWindow *window : window_list)
+    {
+        passes_before += window->m_good_central_widget->updatePassCount();
+        requests_before += window->m_good_central_widget->updateRequestCount();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        for (BenchmarkWindow *window : window_list)
+        {
+            window->resize(640 + (i % 2) * 40, 480 + (i % 2) * 30);
+
+            QEvent event((i % 2 == 0) ? QEvent::WindowActivate : QEvent::WindowDeactivate);
+            QApplication::sendEvent(window, &event);
+        }
+
+        qApp->processEvents();
+    }
+
+    qint64 elapsed_ns = timer.nsecsElapsed();
+
+    printResult("resize_activate", iterations, elapsed_ns);
+
+    int passes = -passes_before;
+    int requests = -requests_before;
+
+    for (BenchmarkWindow *window : window_list)
+    {
+        passes += window->m_good_central_widget->updatePassCount();
+        requests += window->m_good_central_widget->updateRequestCount();
+    }
+
+    const int actions = iterations * window_count;
+
+    QTextStream(stdout) << "resize_activate update passes per action: "
+                        << QString::number(qreal(passes) / actions, 'f', 2)
+                        << ", requests per action: "
+                        << QString::number(qreal(requests) / actions, 'f', 2) << "\n";
+
+    qDeleteAll(window_list);
+}
+
+//Toggle the theme, every caption button of every window picks its icons
+//for the new theme.
+static void benchmarkThemeSwitch(int window_count, int iterations)
+{
+    QList<BenchmarkWindow*> window_list;
+
+    for (int i = 0; i < window_count; i++)
+    {
+        BenchmarkWindow *window = new BenchmarkWindow(0);
+        window->resize(640, 480);
+        window->show();
+        window_list.append(window);
+    }
+
+    qApp->processEvents();
+
+    const bool dark = qGoodStateHolder->isCurrentThemeDark();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        qGoodStateHolder->setCurrentThemeDark(i % 2 == 0 ? !dark : dark);
+        qApp->processEvents();
+    }
+
+    qint64 elapsed_ns = timer.nsecsElapsed();
+
+    qGoodStateHolder->setCurrentThemeDark(dark);
+
+    printResult("theme_switch", iterations, elapsed_ns);
+
+    qDeleteAll(window_list);
+}
+
+//Switch between two title bar configurations with eight setters each,
+//with and without a batch update around them.
+static void applyPerspective(QGoodCentralWidget *gcw, QWidget *left, QWidget *right, bool alternate)
+{
+    gcw->setLeftTitleBarWidget(alternate ? nullptr : left);
+    gcw->setRightTitleBarWidget(alternate ? right : nullptr);
+    gcw->setTitleBarVisible(true);
+    gcw->setCaptionButtonsVisible(!alternate);
+    gcw->setIconVisibility(alternate ? QGoodCentralWidget::IconVisibilityType::IconHidden :
+                                       QGoodCentralWidget::IconVisibilityType::IconOnLeftOfWindow);
+    gcw->setTitleVisible(!alternate);
+    gcw->setTitleBarHeight(alternate ? 40 : 30);
+    gcw->setCaptionButtonWidth(alternate ? 40 : 36);
+}
+
+static void benchmarkBatchUpdate(int iterations)
+{
+    for (int batched = 0; batched < 2; batched++)
+    {
+        BenchmarkWindow *window = new BenchmarkWindow(0);
+        window->resize(640, 480);
+        window->show();
+
+        QGoodCentralWidget *gcw = window->m_good_central_widget;
+
+        QPushButton *left = new QPushButton("Left");
+        QPushButton *right = new QPushButton("Right");
+
+        qApp->processEvents();
+
+        const int passes_before = gcw->updatePassCount();
+
+        QElapsedTimer timer;
+        timer.start();
+
+        for (int i = 0; i < iterations; i++)
+        {
+            if (batched)
+            {
+                QGoodCentralWidget::UpdateScope scope(gcw);
+                applyPerspective(gcw, left, right, i % 2 == 1);
+            }
+            else
+            {
+                applyPerspective(gcw, left, right, i % 2 == 1);
+            }
+
+            qApp->processEvents();
+        }
+
+        qint64 elapsed_ns = timer.nsecsElapsed();
+
+        const QString name = batched ? "perspective_switch_batched" : "perspective_switch";
+
+        printResult(name, iterations, elapsed_ns);
+
+        QTextStream(stdout) << name << " update passes per switch: "
+                            << QString::number(qreal(gcw->updatePassCount() - passes_before) / iterations, 'f', 2) << "\n";
+
+        gcw->setLeftTitleBarWidget(nullptr);
+        gcw->setRightTitleBarWidget(nullptr);
+        delete left;
+        delete right;
+        delete window;
+    }
+}
+
+//Repaint the whole central widget and then only its interior, the border
+//is drawn by QGoodCentralWidget on Linux and Windows 10.
+static void benchmarkBorderPaint(int iterations)
+{
+    BenchmarkWindow *window = new BenchmarkWindow(0);
+    window->resize(1920, 1080);
+    window->show();
+
+    qApp->processEvents();
+
+    QGoodCentralWidget *gcw = window->m_good_central_widget;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < iterations; i++)
+        gcw->repaint();
+
+    printResult("border_paint_full", iterations, timer.nsecsElapsed());
+
+    const QRect interior = gcw->rect().adjusted(50, 50, -50, -50);
+
+    timer.start();
+
+    for (int i = 0; i < iterations; i++)
+        gcw->repaint(interior);
+
+    printResult("border_paint_interior", iterations, timer.nsecsElapsed());
+
+    delete window;
+}
+
+//Open a message box with QGoodCentralWidget::execDialogWithWindow and measure
+//the time to its first paint, without and with the dialog window pool.
+static void benchmarkDialogOpen(int iterations)
+{
+    BenchmarkWindow *parent_window = new BenchmarkWindow(0);
+    parent_window->resize(640, 480);
+    parent_window->show();
+
+    //The pool is refilled a while after each dialog opens, so pooled runs
+    //wait for it and are limited to a few dialogs.
+    for (int pool_size = 0; pool_size < 2; pool_size++)
+    {
+        QGoodCentralWidget::setDialogWindowPoolSize(parent_window, pool_size);
+
+        qint64 total_ns = 0;
+        QList<qint64> latency_list;
+
+        const int dialog_count = (pool_size > 0) ? qMin(iterations, 20) : iterations;
+        const int idle_msecs = (pool_size > 0) ? 400 : 50;
+
+        for (int i = 0; i < dialog_count; i++)
+        {
+            //Idle time between dialogs, when the pool is refilled.
+            QElapsedTimer idle_timer;
+            idle_timer.start();
+
+            while (idle_timer.elapsed() < idle_msecs)
+                qApp->processEvents(QEventLoop::AllEvents, 10);
+
+            QMessageBox *message_box = new QMessageBox(QMessageBox::Information, "GoodBenchmark",
+                                                       "Dialog open latency.", QMessageBox::Ok);
+
+            QElapsedTimer timer;
+            FirstPaintWatcher *watcher = new FirstPaintWatcher(message_box, &timer);
+
+            timer.start();
+
+            QGoodCentralWidget::execDialogWithWindow(message_box, parent_window,
+                                                     parent_window->m_good_central_widget);
+
+            qint64 elapsed_ns = qMax(watcher->m_elapsed_ns, qint64(0));
+
+            total_ns += elapsed_ns;
+            latency_list.append(elapsed_ns);
+
+            delete message_box;
+        }
+
+        std::sort(latency_list.begin(), latency_list.end());
+
+        const QString name = pool_size > 0 ? "dialog_open_pooled" : "dialog_open";
+
+        printResult(name, dialog_count, total_ns);
+
+        QTextStream(stdout) << name << " open to first paint median: "
+                            << QString::number(double(latency_list.at(latency_list.size() / 2)) / 1000000.0, 'f', 3)
+                            << " ms\n";
+    }
+
+    QGoodCentralWidget::setDialogWindowPoolSize(parent_window, 0);
+
+    delete parent_window;
+
+    //Time from show to the first paint of a parent window whose dialog
+    //pool is set up before it's shown, the pool must not delay it.
+    for (int pool_size = 0; pool_size <= 2; pool_size += 2)
+    {
+        const int window_count = qMin(iterations, 10);
+
+        qint64 total_ns = 0;
+
+        for (int i = 0; i < window_count; i++)
+        {
+            BenchmarkWindow *window = new BenchmarkWindow(0);
+            window->resize(640, 480);
+
+            QGoodCentralWidget::setDialogWindowPoolSize(window, pool_size);
+
+            QElapsedTimer timer;
+            WidgetFirstPaintWatcher *watcher = new WidgetFirstPaintWatcher(window->m_good_central_widget, &timer);
+
+            timer.start();
+
+            window->show();
+
+            while (watcher->m_elapsed_ns < 0 && timer.elapsed() < 2000)
+                qApp->processEvents(QEventLoop::AllEvents, 10);
+
+            total_ns += qMax(watcher->m_elapsed_ns, qint64(0));
+
+            //Let the pool fill before the window is destroyed.
+            waitForEvents(600);
+
+            delete window;
+        }
+
+        printResult(pool_size > 0 ? "parent_first_paint_pooled" : "parent_first_paint", window_count, total_ns);
+    }
+}
+
+//Open dialogs with QGoodCentralWidget::execDialogWithWindow and count the
+//geometry changes after the dialog window is mapped, on Linux the final
+//geometry must be set before mapping, so the window is never resized after.
+static bool checkDialogConfigures(int iterations)
+{
+    BenchmarkWindow *parent_window = new BenchmarkWindow(0);
+    parent_window->resize(640, 480);
+    parent_window->show();
+
+    qApp->processEvents();
+
+    int resize_count = 0;
+    int move_count = 0;
+
+    iterations = qMin(iterations, 10);
+
+    for (int i = 0; i < iterations; i++)
+    {
+        QMessageBox *message_box = new QMessageBox(QMessageBox::Information, "GoodBenchmark",
+                                                   "Dialog configure count.", QMessageBox::Ok);
+
+        ConfigureCounter *counter = new ConfigureCounter(message_box);
+
+        QGoodCentralWidget::execDialogWithWindow(message_box, parent_window,
+                                                 parent_window->m_good_central_widget);
+
+        resize_count += counter->m_resize_count;
+        move_count += counter->m_move_count;
+
+        delete message_box;
+    }
+
+    delete parent_window;
+
+    QTextStream(stdout) << "dialog_configure: " << iterations << " dialogs, "
+                        << QString::number(qreal(resize_count) / iterations, 'f', 2) << " resizes and "
+                        << QString::number(qreal(move_count) / iterations, 'f', 2) << " moves per dialog after show\n";
+
+#ifdef Q_OS_LINUX
+    if (resize_count > 0)
+    {
+        QTextStream(stdout) << "dialog_configure: FAILED, dialog windows were resized after being shown\n";
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+//Change the title once per iteration and count the title widget paints,
+//one change must result in exactly one paint.
+static bool checkTitlePaints(int iterations)
+{
+    BenchmarkWindow *window = new BenchmarkWindow(0);
+    window->resize(640, 480);
+    window->show();
+
+    QElapsedTimer settle_timer;
+    settle_timer.start();
+
+    while (settle_timer.elapsed() < 500)
+        qApp->processEvents(QEventLoop::AllEvents, 50);
+
+    PaintCounter counter("TitleWidget");
+    qApp->installEventFilter(&counter);
+
+    int max_paints = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        counter.m_count = 0;
+
+        window->setWindowTitle(QString("GoodBenchmark - %0%").arg(i % 101));
+
+        qApp->processEvents();
+        qApp->processEvents();
+
+        max_paints = qMax(max_paints, counter.m_count);
+    }
+
+    qint64 elapsed_ns = timer.nsecsElapsed();
+
+    qApp->removeEventFilter(&counter);
+
+    printResult("title_change", iterations, elapsed_ns);
+
+    QTextStream(stdout) << "title_change max paints per change: " << max_paints << "\n";
+
+    delete window;
+
+    return (max_paints <= 1);
+}
+
+#ifdef QGOODWINDOW
+//A title bar slot widget with a given size hint.
+class SlotWidget : public QWidget
+{
+public:
+    explicit SlotWidget(int hint_width, QWidget *parent = nullptr) : QWidget(parent)
+    {
+        m_hint_width = hint_width;
+    }
+
+    QSize sizeHint() const
+    {
+        return QSize(m_hint_width, 30);
+    }
+
+    int m_hint_width;
+};
+
+//Lay out the title bar slots in widths down to zero and check that
+//no slot overlaps another or leaves the title bar, and that slots
+//only go below their minimum width when all of them are at it.
+static bool checkTitleBarNarrow()
+{
+    QWidget title_bar;
+
+    TitleBarLayout *layout = new TitleBarLayout(&title_bar);
+
+    struct SlotSpec
+    {
+        TitleBarLayout::Slot slot;
+        int hint_width;
+        int minimum_width;
+    };
+
+    //Fixed margin, icon and caption buttons, shrinkable title bar widgets.
+    const QList<SlotSpec> spec_list = QList<SlotSpec>()
+            << SlotSpec{TitleBarLayout::Slot::LeftMargin, 8, -1}
+            << SlotSpec{TitleBarLayout::Slot::Icon, 30, -1}
+            << SlotSpec{TitleBarLayout::Slot::Left, 120, 40}
+            << SlotSpec{TitleBarLayout::Slot::Center, 200, 60}
+            << SlotSpec{TitleBarLayout::Slot::Right, 120, 40}
+            << SlotSpec{TitleBarLayout::Slot::CaptionButtons, 138, -1};
+
+    int minimum_total_width = 0;
+
+    for (const SlotSpec &spec : spec_list)
+    {
+        SlotWidget *widget = new SlotWidget(spec.hint_width, &title_bar);
+
+        if (spec.minimum_width < 0)
+            widget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+        else
+            widget->setMinimumWidth(spec.minimum_width);
+
+        layout->setSlotWidget(spec.slot, widget);
+
+        minimum_total_width += (spec.minimum_width < 0) ? spec.hint_width : spec.minimum_width;
+    }
+
+    int failure_count = 0;
+
+    for (int width = 800; width >= 0; width -= 5)
+    {
+        const QRect title_bar_rect = QRect(0, 0, width, 30);
+
+        layout->setGeometry(title_bar_rect);
+
+        QList<QRect> rect_list;
+
+        for (const SlotSpec &spec : spec_list)
+        {
+            const QRect rect = layout->slotRect(spec.slot);
+
+            const int minimum_width = (spec.minimum_width < 0) ? spec.hint_width : spec.minimum_width;
+
+            bool failed = false;
+
+            if (rect.width() > 0 && !title_bar_rect.contains(rect))
+                failed = true;
+
+            if (width >= minimum_total_width && rect.width() < minimum_width)
+                failed = true;
+
+            for (const QRect &other_rect : rect_list)
+            {
+                if (rect.intersects(other_rect))
+                    failed = true;
+            }
+
+            if (failed)
+            {
+                QTextStream(stdout) << "title_bar_narrow: slot " << int(spec.slot) << " at width " << width
+                                    << " placed at " << rect.x() << " with width " << rect.width() << "\n";
+                failure_count++;
+            }
+
+            rect_list.append(rect);
+        }
+    }
+
+    QTextStream(stdout) << "title_bar_narrow: " << failure_count << " misplaced slots\n";
+
+    return (failure_count == 0);
+}
+#endif
+
+//Reference per pixel loops, as the icon filters were written before
+//QGoodImageFilter.
+static QImage referenceGrayscaled(const QImage &image)
+{
+    QImage tmp = image;
+
+    for (int y = 0; y < tmp.height(); y++)
+    {
+        QRgb *pixel_ptr = reinterpret_cast<QRgb*>(tmp.scanLine(y));
+
+        for (int x = 0; x < tmp.width(); x++)
+        {
+            QRgb pixel = pixel_ptr[x];
+
+            int gray = qGray(pixel);
+
+            pixel_ptr[x] = qRgba(gray, gray, gray, qAlpha(pixel));
+        }
+    }
+
+    return tmp;
+}
+
+static QImage referenceDimmed(const QImage &image, qreal factor)
+{
+    QImage tmp = image;
+
+    for (int y = 0; y < tmp.height(); y++)
+    {
+        QRgb *pixel_ptr = reinterpret_cast<QRgb*>(tmp.scanLine(y));
+
+        for (int x = 0; x < tmp.width(); x++)
+        {
+            QRgb pixel = pixel_ptr[x];
+
+            pixel_ptr[x] = qRgba(qRound(qRed(pixel) * factor),
+                                 qRound(qGreen(pixel) * factor),
+                                 qRound(qBlue(pixel) * factor),
+                                 qAlpha(pixel));
+        }
+    }
+
+    return tmp;
+}
+
+static QImage referenceInverted(const QImage &image)
+{
+    //Premultiplied colors are inverted unpremultiplied, so they stay valid.
+    if (image.format() == QImage::Format_ARGB32_Premultiplied)
+    {
+        QImage tmp = image.convertToFormat(QImage::Format_ARGB32);
+        tmp.invertPixels();
+        return tmp.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+
+    QImage tmp = image;
+    tmp.invertPixels();
+    return tmp;
+}
+
+//An image with odd widths, so the scalar tail after the vectorized body of
+//every kernel runs, and with the edge alpha values of premultiplied pixels.
+static QImage filterTestImage(int width, QImage::Format format)
+{
+    QImage image(width, 7, format);
+
+    const int alpha_list[] = {0, 1, 2, 127, 128, 254, 255};
+
+    quint32 seed = quint32(width) * 2654435761u + quint32(format);
+
+    for (int y = 0; y < image.height(); y++)
+    {
+        QRgb *pixel_ptr = reinterpret_cast<QRgb*>(image.scanLine(y));
+
+        for (int x = 0; x < image.width(); x++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+
+            const int alpha = (format == QImage::Format_RGB32) ? 255 : alpha_list[(x + y) % 7];
+
+            //Premultiplied colors can't be larger than the alpha.
+            const int max = (format == QImage::Format_ARGB32_Premultiplied) ? alpha : 255;
+
+            const int channel_list[] = {0, max, max / 2, int((seed >> 8) % quint32(max + 1)),
+                                        int((seed >> 16) % quint32(max + 1))};
+
+            pixel_ptr[x] = qRgba(channel_list[x % 5],
+                                 channel_list[(x + y + 1) % 5],
+                                 channel_list[(seed >> 24) % 5],
+                                 alpha);
+        }
+    }
+
+    return image;
+}
+
+//Returns the largest difference between the color channels of two images,
+//or -1 if the size, the format or any alpha differs.
+static int maxChannelDifference(const QImage &image1, const QImage &image2)
+{
+    if (image1.size() != image2.size() || image1.format() != image2.format())
+        return -1;
+
+    int max_difference = 0;
+
+    for (int y = 0; y < image1.height(); y++)
+    {
+        const QRgb *pixel1_ptr = reinterpret_cast<const QRgb*>(image1.constScanLine(y));
+        const QRgb *pixel2_ptr = reinterpret_cast<const QRgb*>(image2.constScanLine(y));
+
+        for (int x = 0; x < image1.width(); x++)
+        {
+            const QRgb pixel1 = pixel1_ptr[x];
+            const QRgb pixel2 = pixel2_ptr[x];
+
+            if (qAlpha(pixel1) != qAlpha(pixel2))
+                return -1;
+
+            max_difference = qMax(max_difference, qAbs(qRed(pixel1) - qRed(pixel2)));
+            max_difference = qMax(max_difference, qAbs(qGreen(pixel1) - qGreen(pixel2)));
+            max_difference = qMax(max_difference, qAbs(qBlue(pixel1) - qBlue(pixel2)));
+        }
+    }
+
+    return max_difference;
+}
+
+//Compare the filters of the compiled backend with the reference loops.
+static bool checkImageFilter()
+{
+    bool passed = true;
+
+    auto check = [&](const QString &name, int width, QImage::Format format,
+            const QImage &result, const QImage &reference, int tolerance){
+        const int difference = maxChannelDifference(result, reference);
+
+        if (difference >= 0 && difference <= tolerance)
+            return;
+
+        QTextStream(stdout) << "image_filter mismatch: " << name << " width " << width
+                            << " format " << int(format) << " difference " << difference << "\n";
+
+        passed = false;
+    };
+
+    const QList<QImage::Format> format_list = QList<QImage::Format>()
+            << QImage::Format_RGB32 << QImage::Format_ARGB32 << QImage::Format_ARGB32_Premultiplied;
+
+    const QList<int> width_list = QList<int>() << 1 << 3 << 5 << 7 << 9 << 15 << 17 << 31 << 33 << 257;
+
+    const QList<qreal> factor_list = QList<qreal>() << qreal(0) << qreal(0.40) << qreal(0.5) << qreal(0.99);
+
+    for (QImage::Format format : format_list)
+    {
+        for (int width : width_list)
+        {
+            const QImage image = filterTestImage(width, format);
+
+            //The gray weights are the same integer math, any difference is a kernel bug.
+            check("grayscale", width, format, QGoodImageFilter::grayscaled(image), referenceGrayscaled(image), 0);
+
+            //The fixed point product may round differently than qRound by one.
+            for (qreal factor : factor_list)
+            {
+                check(QString("dim_%0").arg(factor), width, format,
+                      QGoodImageFilter::dimmed(image, factor), referenceDimmed(image, factor), 1);
+            }
+
+            //Qt's unpremultiply and premultiply round trip may differ from alpha - color by one.
+            check("invert", width, format, QGoodImageFilter::inverted(image), referenceInverted(image),
+                  (format == QImage::Format_ARGB32_Premultiplied) ? 1 : 0);
+        }
+    }
+
+    QTextStream(stdout) << "image_filter " << QGoodImageFilter::backendName() << " matches reference: "
+                        << (passed ? "yes" : "no") << "\n";
+
+    return passed;
+}
+
+//Filter large multi resolution window icons, as done when the window
+//icon changes.
+static void benchmarkImageFilter(int iterations)
+{
+    QTextStream(stdout) << "image_filter backend: " << QGoodImageFilter::backendName() << "\n";
+
+    const QList<int> size_list = QList<int>() << 256 << 512 << 1024;
+
+    for (int size : size_list)
+    {
+        QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+
+        {
+            QRadialGradient gradient(QPointF(size / 2, size / 2), size / 2);
+            gradient.setColorAt(0, QColor(255, 128, 0, 255));
+            gradient.setColorAt(1, QColor(0, 64, 255, 64));
+
+            QPainter painter(&image);
+            painter.setRenderHint(QPainter::Antialiasing);
+            painter.setBrush(gradient);
+            painter.setPen(Qt::NoPen);
+            painter.drawEllipse(image.rect());
+        }
+
+        const int count = qMax(iterations / (size / 256), 1);
+
+        const QString suffix = QString("_%0").arg(size);
+
+        QElapsedTimer timer;
+
+        timer.start();
+        for (int i = 0; i < count; i++)
+            referenceGrayscaled(image);
+        printResult("image_grayscale_reference" + suffix, count, timer.nsecsElapsed());
+
+        timer.start();
+        for (int i = 0; i < count; i++)
+            QGoodImageFilter::grayscaled(image);
+        printResult("image_grayscale" + suffix, count, timer.nsecsElapsed());
+
+        timer.start();
+        for (int i = 0; i < count; i++)
+            referenceDimmed(image, qreal(0.40));
+        printResult("image_dim_reference" + suffix, count, timer.nsecsElapsed());
+
+        timer.start();
+        for (int i = 0; i < count; i++)
+            QGoodImageFilter::dimmed(image, qreal(0.40));
+        printResult("image_dim" + suffix, count, timer.nsecsElapsed());
+
+        timer.start();
+        for (int i = 0; i < count; i++)
+            referenceInverted(image);
+        printResult("image_invert_reference" + suffix, count, timer.nsecsElapsed());
+
+        timer.start();
+        for (int i = 0; i < count; i++)
+            QGoodImageFilter::inverted(image);
+        printResult("image_invert" + suffix, count, timer.nsecsElapsed());
+    }
+}
+
+//Open window_count windows and report what each one costs, as measured by
+//the heap, the X server resources and the library's own estimate.
+static void benchmarkFootprint(int window_count)
+{
+    //Owns a native window so the X client can be found, and keeps the
+    //process wide resources created by the first window out of the deltas.
+    BenchmarkWindow *probe_window = new BenchmarkWindow(0);
+    probe_window->show();
+
+    waitForEvents(200);
+
+    const FootprintSample before = sampleFootprint(probe_window);
+
+    QList<BenchmarkWindow*> window_list;
+
+    for (int i = 0; i < window_count; i++)
+    {
+        BenchmarkWindow *window = new BenchmarkWindow(0);
+        window->resize(320, 240);
+        window->show();
+        window_list.append(window);
+    }
+
+    waitForEvents(500);
+
+    const FootprintSample after = sampleFootprint(probe_window);
+
+    auto print_delta = [=](const QString &name, qint64 before_value, qint64 after_value, const QString &unit){
+        if (before_value < 0 || after_value < 0)
+        {
+            QTextStream(stdout) << name << ": not available\n";
+            return;
+        }
+
+        printValue(name, double(after_value - before_value) / window_count, unit);
+    };
+
+    print_delta("footprint_heap_per_window", before.heap_bytes, after.heap_bytes, "bytes");
+    print_delta("footprint_x_pixmap_per_window", before.x_pixmap_bytes, after.x_pixmap_bytes, "bytes");
+    print_delta("footprint_x_windows_per_window", before.x_window_count, after.x_window_count, "windows");
+    print_delta("footprint_x_pixmaps_per_window", before.x_pixmap_count, after.x_pixmap_count, "pixmaps");
+
+    //The estimate of the library, split by kind.
+    QMap<QString, double> estimate_map;
+
+    for (BenchmarkWindow *window : window_list)
+    {
+        QVariantMap map = window->footprint();
+
+        const QVariantMap gcw_map = window->m_good_central_widget->footprint();
+
+        for (const QString &key : gcw_map.keys())
+        {
+            if (key == "shared_caption_icon_bytes")
+                continue;
+
+            map.insert(key, map.value(key).toDouble() + gcw_map.value(key).toDouble());
+        }
+
+        for (const QString &key : map.keys())
+            estimate_map[key] += map.value(key).toDouble();
+    }
+
+    for (const QString &key : estimate_map.keys())
+        printValue("footprint_estimate_" + key, estimate_map.value(key) / window_count,
+                   key.endsWith("_bytes") ? "bytes" : "per window");
+
+    printValue("footprint_shared_caption_icon_bytes",
+               probe_window->m_good_central_widget->footprint().value("shared_caption_icon_bytes").toDouble(),
+               "bytes");
+
+    //Hidden windows after the rebuildable state is released.
+    for (BenchmarkWindow *window : window_list)
+    {
+        window->hide();
+        window->releaseCachedResources();
+    }
+
+    waitForEvents(500);
+
+    const FootprintSample released = sampleFootprint(probe_window);
+
+    print_delta("footprint_heap_per_released_window", before.heap_bytes, released.heap_bytes, "bytes");
+    print_delta("footprint_x_pixmap_per_released_window", before.x_pixmap_bytes, released.x_pixmap_bytes, "bytes");
+    print_delta("footprint_x_windows_per_released_window", before.x_window_count, released.x_window_count, "windows");
+
+    qDeleteAll(window_list);
+
+    waitForEvents(200);
+
+    //The same for bare QMainWindows, as the reference for released windows.
+    const FootprintSample bare_before = sampleFootprint(probe_window);
+
+    QList<QMainWindow*> bare_window_list;
+
+    for (int i = 0; i < window_count; i++)
+    {
+        QMainWindow *window = new QMainWindow();
+        window->setCentralWidget(new QWidget(window));
+        window->resize(320, 240);
+        window->show();
+        bare_window_list.append(window);
+    }
+
+    waitForEvents(500);
+
+    for (QMainWindow *window : bare_window_list)
+        window->hide();
+
+    waitForEvents(500);
+
+    const FootprintSample bare_after = sampleFootprint(probe_window);
+
+    print_delta("footprint_heap_per_hidden_bare_window", bare_before.heap_bytes, bare_after.heap_bytes, "bytes");
+    print_delta("footprint_x_pixmap_per_hidden_bare_window", bare_before.x_pixmap_bytes, bare_after.x_pixmap_bytes, "bytes");
+    print_delta("footprint_x_windows_per_hidden_bare_window", bare_before.x_window_count, bare_after.x_window_count, "windows");
+
+    qDeleteAll(bare_window_list);
+
+    delete probe_window;
+}
+
+//Construct windows that are never shown, as prepared tear off windows are,
+//reporting the time, heap and X server windows each one costs.
+static void benchmarkConstructHidden(int iterations)
+{
+    //Keeps the process wide resources created by the first window out of the deltas.
+    BenchmarkWindow *probe_window = new BenchmarkWindow(0);
+    probe_window->show();
+
+    waitForEvents(200);
+
+    const FootprintSample before = sampleFootprint(probe_window);
+
+    QList<BenchmarkWindow*> window_list;
+    window_list.reserve(iterations);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < iterations; i++)
+        window_list.append(new BenchmarkWindow(0));
+
+    printResult("construct_hidden", iterations, timer.nsecsElapsed());
+
+    qApp->processEvents();
+
+    const FootprintSample after = sampleFootprint(probe_window);
+
+    if (before.heap_bytes >= 0 && after.heap_bytes >= 0)
+        printValue("construct_hidden_heap_per_window", double(after.heap_bytes - before.heap_bytes) / iterations, "bytes");
+
+    if (before.x_window_count >= 0 && after.x_window_count >= 0)
+        printValue("construct_hidden_x_windows_per_window", double(after.x_window_count - before.x_window_count) / iterations, "windows");
+
+    timer.start();
+
+    qDeleteAll(window_list);
+
+    printResult("destroy_hidden", iterations, timer.nsecsElapsed());
+
+    delete probe_window;
+}
+
+//Create, show and destroy window_count small windows, as an application
+//with many tear off windows does, reporting time and heap per window.
+static void benchmarkStress(int window_count)
+{
+    //Keeps the process wide resources created by the first window out of the deltas.
+    BenchmarkWindow *probe_window = new BenchmarkWindow(0);
+    probe_window->show();
+
+    waitForEvents(200);
+
+    auto print_heap = [=](const QString &name, const FootprintSample &before, const FootprintSample &after){
+        if (before.heap_bytes < 0 || after.heap_bytes < 0)
+        {
+            QTextStream(stdout) << name << ": not available\n";
+            return;
+        }
+
+        printValue(name, double(after.heap_bytes - before.heap_bytes) / window_count, "bytes");
+    };
+
+    QList<BenchmarkWindow*> window_list;
+    window_list.reserve(window_count);
+
+    const FootprintSample start = sampleFootprint(probe_window);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < window_count; i++)
+    {
+        BenchmarkWindow *window = new BenchmarkWindow(0);
+        window->resize(200, 150);
+        window_list.append(window);
+    }
+
+    printResult("stress_create", window_count, timer.nsecsElapsed());
+
+    print_heap("stress_create_heap_per_window", start, sampleFootprint(probe_window));
+
+    timer.start();
+
+    for (BenchmarkWindow *window : window_list)
+        window->show();
+
+    qApp->processEvents();
+
+    printResult("stress_show", window_count, timer.nsecsElapsed());
+
+    print_heap("stress_show_heap_per_window", start, sampleFootprint(probe_window));
+
+    timer.start();
+
+    //Destroy in creation order, the worst case for a list based registry.
+    qDeleteAll(window_list);
+    window_list.clear();
+
+    qApp->processEvents();
+
+    printResult("stress_destroy", window_count, timer.nsecsElapsed());
+
+    //What is left after all windows are gone.
+    print_heap("stress_retained_heap_per_window", start, sampleFootprint(probe_window));
+
+    delete probe_window;
+}
+
+//Leave window_count windows idle and report how often the scheduler
+//that runs the deferred work of the chrome wakes the process up.
+static void benchmarkIdleWakeups(int window_count)
+{
+    QList<BenchmarkWindow*> window_list;
+
+    for (int i = 0; i < window_count; i++)
+    {
+        BenchmarkWindow *window = new BenchmarkWindow(0);
+        window->resize(320, 240);
+        window->show();
+        window_list.append(window);
+    }
+
+    //Let the work caused by showing the windows settle.
+    waitForEvents(1000);
+
+    QGoodWindow::resetProcessStats();
+
+    QEventLoop loop;
+    QTimer::singleShot(2000, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    printValue("idle_scheduler_wakeups_per_second", QGoodWindow::processStats().schedulerWakeupsPerSecond(), "wakeups/s");
+
+    qDeleteAll(window_list);
+}
+
+//Work done by all windows during the run, as reported by the library.
+static void printProcessStats()
+{
+    const QGoodWindowStats stats = QGoodWindow::processStats();
+
+    QTextStream out(stdout);
+
+    for (int i = 0; i < QGoodWindowStats::CounterCount; i++)
+    {
+        const QGoodWindowStats::Counter counter = QGoodWindowStats::Counter(i);
+
+        out << "stats " << QGoodWindowStats::counterName(counter) << ": "
+            << stats.count(counter) << " times, "
+            << QString::number(double(stats.nsecs(counter)) / 1000000.0, 'f', 3) << " ms\n";
+    }
+
+    out << "stats x_requests: " << stats.xRequestCount() << "\n";
+    out << "stats scheduler_wakeups_per_second: " << QString::number(stats.schedulerWakeupsPerSecond(), 'f', 2) << "\n";
+}
+
+static bool writeResults(const QString &file_name, bool passed)
+{
+    QJsonObject root;
+    root.insert("platform", QGuiApplication::platformName());
+    root.insert("qt_version", QString(qVersion()));
+    root.insert("passed", passed);
+    root.insert("stats", QJsonObject::fromVariantMap(QGoodWindow::processStats().toVariantMap()));
+    root.insert("results", json_results);
+
+    QFile file(file_name);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        QTextStream(stderr) << "Can't write " << file_name << "\n";
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson());
+
+    return true;
+}
+
+static QJsonObject readResults(const QString &file_name)
+{
+    QFile file(file_name);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return QJsonObject();
+
+    return QJsonDocument::fromJson(file.readAll()).object().value("results").toObject();
+}
+
+//Print the change of the time per iteration of every result found in both
+//files, returns 1 if any of them got slower than the threshold.
+static int compareResults(const QString &base_file_name, const QString &current_file_name, double threshold)
+{
+    const QJsonObject base = readResults(base_file_name);
+    const QJsonObject current = readResults(current_file_name);
+
+    if (base.isEmpty() || current.isEmpty())
+    {
+        QTextStream(stderr) << "No results to compare\n";
+        return 2;
+    }
+
+    QTextStream out(stdout);
+
+    int regressions = 0;
+
+    for (const QString &name : current.keys())
+    {
+        if (!base.contains(name))
+        {
+            out << name << ": new\n";
+            continue;
+        }
+
+        const double base_us = base.value(name).toObject().value("per_iteration_us").toDouble();
+        const double current_us = current.value(name).toObject().value("per_iteration_us").toDouble();
+
+        if (base_us <= 0)
+            continue;
+
+        const double change = (current_us - base_us) / base_us * 100.0;
+
+        const bool regression = (change > threshold);
+
+        if (regression)
+            regressions++;
+
+        out << name << ": " << QString::number(base_us, 'f', 3) << " -> "
+            << QString::number(current_us, 'f', 3) << " us/iteration, "
+            << (change >= 0 ? "+" : "") << QString::number(change, 'f', 1) << "%"
+            << (regression ? " REGRESSION" : "") << "\n";
+    }
+
+    for (const QString &name : base.keys())
+    {
+        if (!current.contains(name))
+            out << name << ": missing\n";
+    }
+
+    out << regressions << " regressions over " << QString::number(threshold, 'f', 1) << "%\n";
+
+    return (regressions > 0) ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QGoodWindow::setup();
+
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("QGoodWindow benchmarks, run headless with QT_QPA_PLATFORM=offscreen "
+                                     "or under Xvfb.");
+    parser.addHelpOption();
+
+    QCommandLineOption iterations_option("iterations", "Number of iterations.", "count", "200");
+    QCommandLineOption windows_option("windows", "Number of windows.", "count", "4");
+    QCommandLineOption children_option("children", "Number of central widget children.", "count", "200");
+    QCommandLineOption stress_windows_option("stress-windows", "Number of windows of the stress scenario.", "count", "5000");
+    QCommandLineOption scenario_option("scenario", "Run only the named scenario.", "name");
+    QCommandLineOption json_option("json", "Write the results to a JSON file.", "file");
+    QCommandLineOption compare_option("compare", "Compare two JSON files given as arguments instead of running.");
+    QCommandLineOption threshold_option("threshold", "Slowdown in percent reported as a regression by --compare.",
+                                        "percent", "10");
+
+    parser.addOption(iterations_option);
+    parser.addOption(windows_option);
+    parser.addOption(children_option);
+    parser.addOption(stress_windows_option);
+    parser.addOption(scenario_option);
+    parser.addOption(json_option);
+    parser.addOption(compare_option);
+    parser.addOption(threshold_option);
+
+    parser.addPositionalArgument("base", "Base JSON file, with --compare.", "[base]");
+    parser.addPositionalArgument("current", "Current JSON file, with --compare.", "[current]");
+
+    parser.process(app);
+
+    if (parser.isSet(compare_option))
+    {
+        const QStringList file_list = parser.positionalArguments();
+
+        if (file_list.size() != 2)
+        {
+            QTextStream(stderr) << "--compare needs the base and the current JSON files\n";
+            return 2;
+        }
+
+        return compareResults(file_list.at(0), file_list.at(1), parser.value(threshold_option).toDouble());
+    }
+
+    const int iterations = qMax(parser.value(iterations_option).toInt(), 1);
+    const int window_count = qMax(parser.value(windows_option).toInt(), 1);
+    const int child_count = qMax(parser.value(children_option).toInt(), 0);
+    const int stress_window_count = qMax(parser.value(stress_windows_option).toInt(), 1);
+
+    const QString scenario = parser.value(scenario_option);
+
+    if (scenario.isEmpty() || scenario == "construct_destroy")
+        benchmarkConstructDestroy(iterations);
+
+    if (scenario.isEmpty() || scenario == "construct_hidden")
+        benchmarkConstructHidden(iterations);
+
+    if (scenario.isEmpty() || scenario == "resize_storm")
+        benchmarkResizeStorm();
+
+    if (scenario.isEmpty() || scenario == "state_toggle")
+        benchmarkStateToggle(iterations);
+
+    if (scenario.isEmpty() || scenario == "title_update_60hz")
+        benchmarkTitleUpdates60Hz(iterations);
+
+    if (scenario.isEmpty() || scenario == "hit_test")
+        benchmarkHitTest(iterations);
+
+    if (scenario.isEmpty() || scenario == "resize_activate")
+        benchmarkResizeActivate(window_count, child_count, iterations);
+
+    if (scenario.isEmpty() || scenario == "theme_switch")
+        benchmarkThemeSwitch(window_count, iterations);
+
+    if (scenario.isEmpty() || scenario == "batch_update")
+        benchmarkBatchUpdate(iterations);
+
+    if (scenario.isEmpty() || scenario == "border_paint")
+        benchmarkBorderPaint(iterations);
+
+    if (scenario.isEmpty() || scenario == "dialog_open")
+        benchmarkDialogOpen(iterations);
+
+    bool passed = true;
+
+    if (scenario.isEmpty() || scenario == "title_change")
+        passed = checkTitlePaints(iterations) && passed;
+
+    if (scenario.isEmpty() || scenario == "dialog_configure")
+        passed = checkDialogConfigures(iterations) && passed;
+
+#ifdef QGOODWINDOW
+    if (scenario.isEmpty() || scenario == "title_bar_narrow")
+        passed = checkTitleBarNarrow() && passed;
+#endif
+
+    if (scenario.isEmpty() || scenario == "image_filter")
+    {
+        passed = checkImageFilter() && passed;
+        benchmarkImageFilter(iterations);
+    }
+
+    if (scenario.isEmpty() || scenario == "footprint")
+        benchmarkFootprint(window_count);
+
+    if (scenario.isEmpty() || scenario == "idle_wakeups")
+        benchmarkIdleWakeups(window_count);
+
+    //Takes a long time, only run when asked for.
+    if (scenario == "stress")
+        benchmarkStress(stress_window_count);
+
+    printProcessStats();
+
+    if (parser.isSet(json_option) && !writeResults(parser.value(json_option), passed))
+        passed = false;
+
+    return passed ? 0 : 1;
+}
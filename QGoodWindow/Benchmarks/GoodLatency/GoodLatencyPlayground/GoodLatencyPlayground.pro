@@ -0,0 +1,45 @@
+#The MIT License (MIT)
+
+#Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+#Permission is hereby granted, free of charge, to any person obtaining a copy
+#of this software and associated documentation files (the "Software"), to deal
+#in the Software without restriction, including without limitation the rights
+#to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#copies of the Software, and to permit persons to whom the Software is
+#furnished to do so, subject to the following conditions:
+
+#The above copyright notice and this permission notice shall be included in all
+#copies or substantial portions of the Software.
+
+#THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+#SOFTWARE.
+
+QT += core gui widgets
+
+CONFIG += c++11 console
+
+include($$PWD/../../../QGoodWindow/QGoodWindow.pri)
+
+include($$PWD/../../../QGoodCentralWidget/QGoodCentralWidget.pri)
+
+INCLUDEPATH += \
+    $$PWD/.. \
+    $$PWD/../../../Examples/GoodPlayground
+
+#The GoodPlayground example is the fixture, built with the harness main.
+SOURCES += \
+    $$PWD/../main.cpp \
+    $$PWD/../latencyharness.cpp \
+    $$PWD/../../../Examples/GoodPlayground/mainwindow.cpp
+
+HEADERS += \
+    $$PWD/../latencyharness.h \
+    $$PWD/../../../Examples/GoodPlayground/mainwindow.h
+
+LIBS += -lX11 -lXtst
@@ -0,0 +1,323 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "latencyharness.h"
+
+#include <X11/Xlib.h>
+#include <X11/extensions/XTest.h>
+
+LatencyHarness::LatencyHarness(QGoodWindow *gw, int event_count) : QObject()
+{
+    m_gw = gw;
+    m_event_count = qMax(event_count, 2);
+
+    m_signal_ns = -1;
+    m_paint_ns = -1;
+    m_watch_paint = false;
+
+    //A connection of it's own, so the injected events don't depend on Qt's one.
+    m_display = XOpenDisplay(nullptr);
+
+    m_xtest_available = false;
+
+    if (m_display)
+    {
+        int event_base, error_base, major_version, minor_version;
+
+        m_xtest_available = XTestQueryExtension(m_display, &event_base, &error_base,
+                                                &major_version, &minor_version);
+    }
+
+    connect(m_gw, &QGoodWindow::captionButtonStateChanged, this, [=]{
+        if (m_signal_ns < 0)
+            m_signal_ns = m_clock.nsecsElapsed();
+    });
+
+    qApp->installEventFilter(this);
+
+    m_clock.start();
+}
+
+LatencyHarness::~LatencyHarness()
+{
+    qApp->removeEventFilter(this);
+
+    if (m_display)
+        XCloseDisplay(m_display);
+}
+
+bool LatencyHarness::isAvailable() const
+{
+    return (m_display && m_xtest_available && m_gw);
+}
+
+bool LatencyHarness::run()
+{
+    //Let the window be mapped and painted before measuring.
+    waitForEvents(500);
+
+    bool passed = true;
+
+    passed = measureHover() && passed;
+    passed = measureCursor() && passed;
+    passed = measureDrag() && passed;
+
+    return passed;
+}
+
+bool LatencyHarness::eventFilter(QObject *watched, QEvent *event)
+{
+    if (m_watch_paint && m_paint_ns < 0 && event->type() == QEvent::Paint && watched->inherits("CaptionButton"))
+        m_paint_ns = m_clock.nsecsElapsed();
+
+    return QObject::eventFilter(watched, event);
+}
+
+//Move the pointer in and out of a caption button, measuring the hover signal
+//and the next paint of a caption button.
+bool LatencyHarness::measureHover()
+{
+    QWidget *button = findCaptionButton();
+
+    if (!button)
+    {
+        QTextStream(stdout) << "hover: no visible caption button\n";
+        return false;
+    }
+
+    const QPoint button_pos = button->mapToGlobal(button->rect().center());
+    const QPoint outside_pos = m_gw->mapToGlobal(m_gw->rect().center());
+
+    QList<qint64> signal_list;
+    QList<qint64> paint_list;
+
+    m_watch_paint = true;
+
+    for (int i = 0; i < m_event_count; i++)
+    {
+        m_signal_ns = -1;
+        m_paint_ns = -1;
+
+        const qint64 start_ns = m_clock.nsecsElapsed();
+
+        movePointer((i % 2 == 0) ? button_pos : outside_pos);
+
+        waitFor([=]{return (m_signal_ns >= 0 && m_paint_ns >= 0);}, 500);
+
+        if (m_signal_ns >= 0)
+            signal_list.append(m_signal_ns - start_ns);
+
+        if (m_paint_ns >= 0)
+            paint_list.append(m_paint_ns - start_ns);
+    }
+
+    m_watch_paint = false;
+
+    bool passed = true;
+
+    passed = printLatency("hover_signal", signal_list) && passed;
+    passed = printLatency("hover_paint", paint_list) && passed;
+
+    return passed;
+}
+
+//Move the pointer between the window and it's right resize border,
+//measuring the time until the resize cursor is defined.
+bool LatencyHarness::measureCursor()
+{
+    const QRect frame_geom = m_gw->frameGeometry();
+
+    const QPoint inside_pos = frame_geom.center();
+    const QPoint border_pos = QPoint(frame_geom.right() + 2, frame_geom.center().y());
+
+    QList<qint64> latency_list;
+
+    for (int i = 0; i < m_event_count; i++)
+    {
+        const bool to_border = (i % 2 == 0);
+
+        const quint64 count_before = m_gw->stats().count(QGoodWindowStats::Counter::CursorDefine);
+
+        const qint64 start_ns = m_clock.nsecsElapsed();
+
+        movePointer(to_border ? border_pos : inside_pos);
+
+        if (!to_border)
+        {
+            waitForEvents(1);
+            continue;
+        }
+
+        const qint64 done_ns = waitFor([=]{
+            return (m_gw->stats().count(QGoodWindowStats::Counter::CursorDefine) > count_before);
+        }, 500);
+
+        if (done_ns >= 0)
+            latency_list.append(done_ns - start_ns);
+    }
+
+    return printLatency("cursor_define", latency_list);
+}
+
+//Press on the title bar and move, measuring the time until the move request
+//is sent to the window manager.
+bool LatencyHarness::measureDrag()
+{
+    const QPoint title_bar_pos = findTitleBarPoint();
+
+    if (title_bar_pos.isNull())
+    {
+        QTextStream(stdout) << "drag: no free title bar point\n";
+        return false;
+    }
+
+    //Each drag waits for the double click interval, so a press isn't taken
+    //as a double click that maximizes the window.
+    const int drag_count = qMax(m_event_count / 20, 10);
+
+    QList<qint64> latency_list;
+
+    for (int i = 0; i < drag_count; i++)
+    {
+        movePointer(title_bar_pos);
+        waitForEvents(10);
+
+        setButtonPressed(true);
+        waitForEvents(10);
+
+        const quint64 count_before = m_gw->stats().count(QGoodWindowStats::Counter::ClientMessage);
+
+        const qint64 start_ns = m_clock.nsecsElapsed();
+
+        movePointer(title_bar_pos + QPoint(10, 0));
+
+        const qint64 done_ns = waitFor([=]{
+            return (m_gw->stats().count(QGoodWindowStats::Counter::ClientMessage) > count_before);
+        }, 1000);
+
+        if (done_ns >= 0)
+            latency_list.append(done_ns - start_ns);
+
+        setButtonPressed(false);
+
+        waitForEvents(qApp->doubleClickInterval() + 50);
+    }
+
+    return printLatency("drag_start", latency_list);
+}
+
+QWidget *LatencyHarness::findCaptionButton() const
+{
+    const QList<QWidget*> widget_list = m_gw->findChildren<QWidget*>();
+
+    for (QWidget *widget : widget_list)
+    {
+        if (widget->inherits("CaptionButton") && widget->isVisible())
+            return widget;
+    }
+
+    return nullptr;
+}
+
+QPoint LatencyHarness::findTitleBarPoint() const
+{
+    //Any point of the title bar not covered by title bar widgets.
+    const QRect title_bar_rect = m_gw->titleBarRect();
+
+    for (int x = title_bar_rect.left() + 1; x < title_bar_rect.right(); x += 4)
+    {
+        const QPoint pos = m_gw->mapToGlobal(QPoint(x, title_bar_rect.center().y()));
+
+        QWidget *widget = QApplication::widgetAt(pos);
+
+        if (widget && (widget->inherits("TitleBar") || widget->inherits("TitleWidget")))
+            return pos;
+    }
+
+    return QPoint();
+}
+
+void LatencyHarness::movePointer(const QPoint &pos)
+{
+    const qreal pixel_ratio = m_gw->devicePixelRatioF();
+
+    XTestFakeMotionEvent(m_display, -1, qFloor(pos.x() * pixel_ratio), qFloor(pos.y() * pixel_ratio), CurrentTime);
+    XFlush(m_display);
+}
+
+void LatencyHarness::setButtonPressed(bool pressed)
+{
+    XTestFakeButtonEvent(m_display, Button1, pressed ? True : False, CurrentTime);
+    XFlush(m_display);
+}
+
+//Process events until done returns true, returns the time it became true or -1 on timeout.
+qint64 LatencyHarness::waitFor(const std::function<bool()> &done, int timeout_ms)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!done())
+    {
+        if (timer.elapsed() > timeout_ms)
+            return -1;
+
+        qApp->processEvents(QEventLoop::AllEvents);
+    }
+
+    return m_clock.nsecsElapsed();
+}
+
+void LatencyHarness::waitForEvents(int msecs)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while (timer.elapsed() < msecs)
+        qApp->processEvents(QEventLoop::AllEvents, 1);
+}
+
+bool LatencyHarness::printLatency(const QString &name, QList<qint64> latency_list)
+{
+    QTextStream out(stdout);
+
+    if (latency_list.isEmpty())
+    {
+        out << name << ": FAILED, no feedback was observed\n";
+        return false;
+    }
+
+    std::sort(latency_list.begin(), latency_list.end());
+
+    const int size = latency_list.size();
+
+    const qint64 p50 = latency_list.at(size * 50 / 100);
+    const qint64 p99 = latency_list.at(qMin(size * 99 / 100, size - 1));
+
+    out << name << ": " << size << " events, p50 "
+        << QString::number(double(p50) / 1000000.0, 'f', 3) << " ms, p99 "
+        << QString::number(double(p99) / 1000000.0, 'f', 3) << " ms\n";
+
+    return true;
+}
@@ -0,0 +1,82 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LATENCYHARNESS_H
+#define LATENCYHARNESS_H
+
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+#include <QGoodWindow>
+
+#include <functional>
+
+struct _XDisplay;
+
+//Drives XTest pointer events against a QGoodWindow on an X11 display,
+//as Xvfb, and measures the time from the pointer event to the feedback.
+class LatencyHarness : public QObject
+{
+public:
+    explicit LatencyHarness(QGoodWindow *gw, int event_count);
+    ~LatencyHarness();
+
+    //The display could be opened and it has the XTest extension.
+    bool isAvailable() const;
+
+    //Runs all measures and prints the percentiles, returns false if a measure
+    //got no feedback at all.
+    bool run();
+
+private:
+    //Functions
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+    bool measureHover();
+    bool measureCursor();
+    bool measureDrag();
+
+    QWidget *findCaptionButton() const;
+    QPoint findTitleBarPoint() const;
+
+    void movePointer(const QPoint &pos);
+    void setButtonPressed(bool pressed);
+    qint64 waitFor(const std::function<bool()> &done, int timeout_ms);
+    void waitForEvents(int msecs);
+
+    static bool printLatency(const QString &name, QList<qint64> latency_list);
+
+    //Variables
+    QPointer<QGoodWindow> m_gw;
+    _XDisplay *m_display;
+    bool m_xtest_available;
+    int m_event_count;
+
+    QElapsedTimer m_clock;
+    qint64 m_signal_ns;
+    qint64 m_paint_ns;
+    bool m_watch_paint;
+};
+
+#endif // LATENCYHARNESS_H
@@ -0,0 +1,59 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <QApplication>
+#include "mainwindow.h"
+#include "latencyharness.h"
+
+//The fixture is the MainWindow of the example this harness is built with,
+//run it on an X11 display with XTest, as Xvfb.
+int main(int argc, char *argv[])
+{
+    QGoodWindow::setup();
+
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("QGoodWindow input latency harness, run under Xvfb.");
+    parser.addHelpOption();
+
+    QCommandLineOption events_option("events", "Number of pointer events per measure.", "count", "2000");
+
+    parser.addOption(events_option);
+
+    parser.process(app);
+
+    MainWindow mw;
+    mw.show();
+
+    LatencyHarness harness(&mw, parser.value(events_option).toInt());
+
+    if (!harness.isAvailable())
+    {
+        QTextStream(stderr) << "An X11 display with the XTest extension is required\n";
+        return 2;
+    }
+
+    return harness.run() ? 0 : 1;
+}
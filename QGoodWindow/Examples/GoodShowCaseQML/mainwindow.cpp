@@ -23,6 +23,7 @@ SOFTWARE.
 */
 
 #include "mainwindow.h"
+#include <src/qgoodimagefilter.h>
 
 MainWindow::MainWindow(QWidget *parent) : QGoodWindow(parent, QColor("#303030"))
 {
@@ -126,27 +127,7 @@ MainWindow::~MainWindow()
 
 QPixmap MainWindow::loadGrayedPixmap(const QPixmap &pix)
 {
-    QImage tmp = pix.toImage();
-
-    for (int y = 0; y < tmp.height(); y++)
-    {
-        QRgb *pixel_ptr = reinterpret_cast<QRgb*>(tmp.scanLine(y));
-
-        for (int x = 0; x < tmp.width(); x++)
-        {
-            QRgb pixel = pixel_ptr[x];
-
-            int gray = qGray(pixel);
-
-            int alpha = qAlpha(pixel);
-
-            QRgb rgba = qRgba(gray, gray, gray, alpha);
-
-            pixel_ptr[x] = rgba;
-        }
-    }
-
-    QPixmap pix_grayed = QPixmap::fromImage(tmp);
+    QPixmap pix_grayed = QPixmap::fromImage(QGoodImageFilter::grayscaled(pix.toImage()));
 
     return pix_grayed;
 }
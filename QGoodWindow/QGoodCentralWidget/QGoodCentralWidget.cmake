@@ -27,8 +27,11 @@ target_sources(${PROJECT_NAME} PRIVATE
 if(qgoodwindow)
     target_sources(${PROJECT_NAME} PRIVATE
         ${CMAKE_CURRENT_LIST_DIR}/src/captionbutton.cpp  ${CMAKE_CURRENT_LIST_DIR}/src/captionbutton.h
+        ${CMAKE_CURRENT_LIST_DIR}/src/captionicons.cpp ${CMAKE_CURRENT_LIST_DIR}/src/captionicons.h
+        ${CMAKE_CURRENT_LIST_DIR}/src/cornerwidget.cpp ${CMAKE_CURRENT_LIST_DIR}/src/cornerwidget.h
         ${CMAKE_CURRENT_LIST_DIR}/src/iconwidget.cpp ${CMAKE_CURRENT_LIST_DIR}/src/iconwidget.h
         ${CMAKE_CURRENT_LIST_DIR}/src/titlebar.cpp ${CMAKE_CURRENT_LIST_DIR}/src/titlebar.h
+        ${CMAKE_CURRENT_LIST_DIR}/src/titlebarlayout.cpp ${CMAKE_CURRENT_LIST_DIR}/src/titlebarlayout.h
         ${CMAKE_CURRENT_LIST_DIR}/src/titlewidget.cpp ${CMAKE_CURRENT_LIST_DIR}/src/titlewidget.h
 
         ${CMAKE_CURRENT_LIST_DIR}/src/qgoodcentralwidget_icons.qrc
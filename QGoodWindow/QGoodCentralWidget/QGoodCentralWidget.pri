@@ -39,14 +39,20 @@ QT += svg
 
 SOURCES += \
     $$PWD/src/captionbutton.cpp \
+    $$PWD/src/captionicons.cpp \
+    $$PWD/src/cornerwidget.cpp \
     $$PWD/src/iconwidget.cpp \
     $$PWD/src/titlebar.cpp \
+    $$PWD/src/titlebarlayout.cpp \
     $$PWD/src/titlewidget.cpp
 
 HEADERS += \
     $$PWD/src/captionbutton.h \
+    $$PWD/src/captionicons.h \
+    $$PWD/src/cornerwidget.h \
     $$PWD/src/iconwidget.h \
     $$PWD/src/titlebar.h \
+    $$PWD/src/titlebarlayout.h \
     $$PWD/src/titlewidget.h
 
 RESOURCES += \
@@ -23,12 +23,15 @@ SOFTWARE.
 */
 
 #include "captionbutton.h"
+#include "captionicons.h"
+#include <QGoodWindow>
 
 CaptionButton::CaptionButton(IconType type, QWidget *parent) : QWidget(parent)
 {
     setVisible(false);
 
     m_type = type;
+    m_pixel_ratio = devicePixelRatioF();
     m_is_active = false;
     m_is_under_mouse = false;
     m_is_pressed = false;
@@ -43,95 +46,21 @@ CaptionButton::~CaptionButton()
 
 }
 
-QPixmap CaptionButton::loadSVG(const QString &svg_path, int w, int h)
-{
-    QPixmap pix = QIcon(svg_path).pixmap(w, h);
-    return pix;
-}
-
-void CaptionButton::paintIcons(const QPixmap &pix_in, bool dark,
-                               QPixmap *pix_active_out, QPixmap *pix_inactive_out)
-{
-    QImage img_active = pix_in.toImage();
-    QImage img_inactive = img_active;
-
-    const qreal grayed_reduction = qreal(0.40);
-
-    for (int y = 0; y < img_inactive.height(); y++)
-    {
-        QRgb *pixel_ptr = reinterpret_cast<QRgb*>(img_inactive.scanLine(y));
-
-        for (int x = 0; x < img_inactive.width(); x++)
-        {
-            QRgb pixel = pixel_ptr[x];
-
-            QRgb rgba = qRgba(qRound(qRed(pixel) * grayed_reduction),
-                              qRound(qGreen(pixel) * grayed_reduction),
-                              qRound(qBlue(pixel) * grayed_reduction),
-                              qAlpha(pixel));
-
-            pixel_ptr[x] = rgba;
-        }
-    }
-
-    if (dark)
-    {
-        img_active.invertPixels();
-        img_inactive.invertPixels();
-    }
-
-    if (pix_active_out)
-        *pix_active_out = QPixmap::fromImage(img_active);
-
-    if (pix_inactive_out)
-        *pix_inactive_out = QPixmap::fromImage(img_inactive);
-}
-
 void CaptionButton::drawIcons()
 {
-    const int size = 10;
+    QGOODWINDOW_TRACE_SCOPE("CaptionButton::drawIcons");
 
-    const int w = size;
-    const int h = size;
+    //Icons come from the shared atlas, so only the first button of each
+    //type, theme and pixel ratio pays for the rasterization.
+    const qreal pixel_ratio = m_pixel_ratio;
 
-    switch (m_type)
-    {
-    case IconType::Minimize:
-    {
-        QPixmap icon = loadSVG(":/icons/minimize.svg", w, h);
-
-        paintIcons(icon, m_icon_dark, &m_active_icon, &m_inactive_icon);
+    m_active_icon = CaptionIcons::icon(m_type, CaptionIcons::Variant::Active, m_icon_dark, pixel_ratio);
+    m_inactive_icon = CaptionIcons::icon(m_type, CaptionIcons::Variant::Inactive, m_icon_dark, pixel_ratio);
 
-        break;
-    }
-    case IconType::Restore:
-    {
-        QPixmap icon = loadSVG(":/icons/restore.svg", w, h);
-
-        paintIcons(icon, m_icon_dark, &m_active_icon, &m_inactive_icon);
-
-        break;
-    }
-    case IconType::Maximize:
-    {
-        QPixmap icon = loadSVG(":/icons/maximize.svg", w, h);
-
-        paintIcons(icon, m_icon_dark, &m_active_icon, &m_inactive_icon);
-
-        break;
-    }
-    case IconType::Close:
-    {
-        QPixmap icon = loadSVG(":/icons/close.svg", w, h);
-
-        paintIcons(icon, m_icon_dark, &m_active_icon, &m_inactive_icon);
-
-        if (m_icon_dark)
-            paintIcons(icon, false/*dark*/, &m_close_icon_hover, nullptr);
-
-        break;
-    }
-    }
+    if (m_type == IconType::Close && m_icon_dark)
+        m_close_icon_hover = CaptionIcons::icon(m_type, CaptionIcons::Variant::CloseHover, m_icon_dark, pixel_ratio);
+    else
+        m_close_icon_hover = QPixmap();
 }
 
 void CaptionButton::setColors()
@@ -180,6 +109,18 @@ void CaptionButton::setIconMode(bool icon_dark)
     update();
 }
 
+void CaptionButton::setPixelRatio(qreal pixel_ratio)
+{
+    if (qFuzzyCompare(m_pixel_ratio, pixel_ratio))
+        return;
+
+    m_pixel_ratio = pixel_ratio;
+
+    drawIcons();
+
+    update();
+}
+
 void CaptionButton::setActive(bool is_active)
 {
     m_is_active = is_active;
@@ -264,13 +205,13 @@ void CaptionButton::paintEvent(QPaintEvent *event)
     }
 
     QPainter painter(this);
-    painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
     painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
 
     painter.fillRect(rect(), current_color);
 
+    //Icons are rendered at the window pixel ratio, draw them unscaled.
     QRect target_rect;
-    target_rect = current_icon.rect();
+    target_rect.setSize((QSizeF(current_icon.size()) / current_icon.devicePixelRatio()).toSize());
     target_rect.moveCenter(rect().center());
-    painter.drawPixmap(target_rect, current_icon);
+    painter.drawPixmap(target_rect.topLeft(), current_icon);
 }
@@ -51,14 +51,12 @@ Q_SIGNALS:
 
 public Q_SLOTS:
     void setIconMode(bool icon_dark);
+    void setPixelRatio(qreal pixel_ratio);
     void setActive(bool is_active);
     void setState(int state);
 
 private:
     //Functions
-    QPixmap loadSVG(const QString &svg_path, int w, int h);
-    void paintIcons(const QPixmap &pix_in, bool dark,
-                    QPixmap *pix_active_out, QPixmap *pix_inactive_out);
     void drawIcons();
     void setColors();
     void paintEvent(QPaintEvent *event);
@@ -74,6 +72,7 @@ private:
     QColor m_pressed;
 
     IconType m_type;
+    qreal m_pixel_ratio;
     bool m_is_active;
     bool m_is_under_mouse;
     bool m_is_pressed;
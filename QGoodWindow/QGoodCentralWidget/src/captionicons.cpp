@@ -0,0 +1,173 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "captionicons.h"
+#include <QGoodWindow>
+#include <src/qgoodimagefilter.h>
+
+namespace CaptionIconsUtils
+{
+//Process wide atlas, every caption button of every window share the
+//same implicitly shared pixmaps for a given type, theme and pixel ratio.
+static QHash<quint64, QPixmap> m_icon_hash;
+static int m_rasterization_count = 0;
+
+static void releaseIcons()
+{
+    //The pixmaps must not outlive the application.
+    m_icon_hash.clear();
+}
+}
+
+QPixmap CaptionIcons::icon(CaptionButton::IconType type, Variant variant, bool dark, qreal pixel_ratio)
+{
+    //Only the close button has a distinct hover icon.
+    if (variant == Variant::CloseHover && (type != CaptionButton::IconType::Close || !dark))
+        variant = Variant::Active;
+
+    const quint64 icon_key = key(type, variant, dark, pixel_ratio);
+
+    if (!CaptionIconsUtils::m_icon_hash.contains(icon_key))
+        rasterize(type, dark, pixel_ratio);
+
+    return CaptionIconsUtils::m_icon_hash.value(icon_key);
+}
+
+int CaptionIcons::rasterizationCount()
+{
+    return CaptionIconsUtils::m_rasterization_count;
+}
+
+qint64 CaptionIcons::atlasBytes()
+{
+    qint64 bytes = 0;
+
+    for (const QPixmap &pixmap : CaptionIconsUtils::m_icon_hash)
+        bytes += QGoodWindow::pixmapBytes(pixmap);
+
+    return bytes;
+}
+
+quint64 CaptionIcons::key(CaptionButton::IconType type, Variant variant, bool dark, qreal pixel_ratio)
+{
+    const quint64 ratio_key = quint64(qMax(qRound(pixel_ratio * 100), 1));
+
+    return (ratio_key << 8) | (quint64(type) << 3) | (quint64(variant) << 1) | quint64(dark ? 1 : 0);
+}
+
+QString CaptionIcons::iconPath(CaptionButton::IconType type)
+{
+    switch (type)
+    {
+    case CaptionButton::IconType::Minimize:
+        return ":/icons/minimize.svg";
+    case CaptionButton::IconType::Restore:
+        return ":/icons/restore.svg";
+    case CaptionButton::IconType::Maximize:
+        return ":/icons/maximize.svg";
+    case CaptionButton::IconType::Close:
+        return ":/icons/close.svg";
+    }
+
+    return QString();
+}
+
+QImage CaptionIcons::loadSVG(const QString &svg_path, int w, int h, qreal pixel_ratio)
+{
+    //Rasterize directly at the device pixel size, so painting is a 1:1 blit.
+    QImage img(qRound(w * pixel_ratio), qRound(h * pixel_ratio), QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::transparent);
+
+    QSvgRenderer renderer(svg_path);
+
+    QPainter painter(&img);
+    renderer.render(&painter);
+    painter.end();
+
+    img.setDevicePixelRatio(pixel_ratio);
+
+    return img;
+}
+
+void CaptionIcons::paintIcons(const QImage &img_in, bool dark,
+                              QPixmap *pix_active_out, QPixmap *pix_inactive_out)
+{
+    QImage img_active = img_in;
+
+    const qreal grayed_reduction = qreal(0.40);
+
+    QImage img_inactive = QGoodImageFilter::dimmed(img_active, grayed_reduction);
+
+    if (dark)
+    {
+        img_active = QGoodImageFilter::inverted(img_active);
+        img_inactive = QGoodImageFilter::inverted(img_inactive);
+    }
+
+    if (pix_active_out)
+        *pix_active_out = QPixmap::fromImage(img_active);
+
+    if (pix_inactive_out)
+        *pix_inactive_out = QPixmap::fromImage(img_inactive);
+}
+
+void CaptionIcons::rasterize(CaptionButton::IconType type, bool dark, qreal pixel_ratio)
+{
+    //The icons are shared by all windows, so only the process wide counter is updated.
+    QGoodWindowStats::Scope stats_scope(nullptr, QGoodWindowStats::Counter::IconRasterization);
+
+    static bool post_routine_added = false;
+
+    if (!post_routine_added)
+    {
+        qAddPostRoutine(&CaptionIconsUtils::releaseIcons);
+        post_routine_added = true;
+    }
+
+    const int size = 10;
+
+    const int w = size;
+    const int h = size;
+
+    QImage icon = loadSVG(iconPath(type), w, h, pixel_ratio);
+
+    QPixmap active_icon;
+    QPixmap inactive_icon;
+
+    paintIcons(icon, dark, &active_icon, &inactive_icon);
+
+    CaptionIconsUtils::m_icon_hash.insert(key(type, Variant::Active, dark, pixel_ratio), active_icon);
+    CaptionIconsUtils::m_icon_hash.insert(key(type, Variant::Inactive, dark, pixel_ratio), inactive_icon);
+
+    if (type == CaptionButton::IconType::Close && dark)
+    {
+        QPixmap close_icon_hover;
+
+        paintIcons(icon, false/*dark*/, &close_icon_hover, nullptr);
+
+        CaptionIconsUtils::m_icon_hash.insert(key(type, Variant::CloseHover, dark, pixel_ratio), close_icon_hover);
+    }
+
+    CaptionIconsUtils::m_rasterization_count++;
+}
@@ -0,0 +1,61 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef CAPTIONICONS_H
+#define CAPTIONICONS_H
+
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+#include <QtSvg>
+#include <QGoodWindow>
+#include "captionbutton.h"
+
+//\cond HIDDEN_SYMBOLS
+class CaptionIcons
+{
+public:
+    enum class Variant
+    {
+        Active,
+        Inactive,
+        CloseHover
+    };
+
+    static QPixmap icon(CaptionButton::IconType type, Variant variant, bool dark, qreal pixel_ratio);
+    static int rasterizationCount();
+    static qint64 atlasBytes();
+
+private:
+    //Functions
+    static quint64 key(CaptionButton::IconType type, Variant variant, bool dark, qreal pixel_ratio);
+    static QString iconPath(CaptionButton::IconType type);
+    static QImage loadSVG(const QString &svg_path, int w, int h, qreal pixel_ratio);
+    static void paintIcons(const QImage &img_in, bool dark,
+                           QPixmap *pix_active_out, QPixmap *pix_inactive_out);
+    static void rasterize(CaptionButton::IconType type, bool dark, qreal pixel_ratio);
+};
+//\endcond
+
+#endif // CAPTIONICONS_H
@@ -0,0 +1,71 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "cornerwidget.h"
+
+CornerWidget::CornerWidget(QWidget *parent) : QWidget(parent)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_NoSystemBackground);
+}
+
+void CornerWidget::setShape(const QRegion &clear_region, const QRegion &border_region, const QColor &border_color)
+{
+    if (m_clear_region == clear_region && m_border_region == border_region && m_border_color == border_color)
+        return;
+
+    m_clear_region = clear_region;
+    m_border_region = border_region;
+    m_border_color = border_color;
+
+    update();
+}
+
+void CornerWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter;
+    if (!painter.begin(this))
+        return;
+
+    //Punch the pixels outside the rounded corner through the content below,
+    //then draw the part of the window border they contain.
+    QPainterPath clear_path;
+    clear_path.addRegion(m_clear_region);
+
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillPath(clear_path, Qt::transparent);
+
+    if (!m_border_region.isEmpty())
+    {
+        QPainterPath border_path;
+        border_path.addRegion(m_border_region);
+
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        painter.fillPath(border_path, m_border_color);
+    }
+
+    painter.end();
+}
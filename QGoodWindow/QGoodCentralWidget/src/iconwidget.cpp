@@ -23,50 +23,167 @@ SOFTWARE.
 */
 
 #include "iconwidget.h"
+#include <src/qgoodimagefilter.h>
 
 #define ICONWIDTH 16
 #define ICONHEIGHT 16
 
-IconWidget::IconWidget(QWidget *parent) : QWidget(parent)
+namespace IconWidgetUtils
 {
-    m_active = true;
-}
+struct RenderedIcon
+{
+    QPixmap pixmap;
+    QPixmap grayed_pixmap;
+};
 
-void IconWidget::setPixmap(const QPixmap &pixmap)
+//The rendered variants of each icon, keyed by the icon cache key and the pixel ratio.
+//Windows showing the same icon, as the default window icon, share the pixmaps.
+static QHash<QPair<qint64, qreal>, RenderedIcon> m_rendered_icon_hash;
+static QPointer<QStyle> m_rendered_icon_style;
+static QString m_rendered_icon_theme;
+
+//Icons no longer in use are dropped all at once past this count.
+static const int m_rendered_icon_max_count = 32;
+
+static void releaseRenderedIcons()
 {
-    m_pixmap = pixmap;
+    //The pixmaps must not outlive the application.
+    m_rendered_icon_hash.clear();
+}
 
-    QImage tmp = m_pixmap.toImage();
+static RenderedIcon &renderedIcon(const QIcon &icon, qreal pixel_ratio, QWidget *widget)
+{
+    //Icons loaded from the style or the icon theme keep their cache key
+    //when these change, so a change renders all icons again.
+    QStyle *style = qApp->style();
+    const QString icon_theme = QIcon::themeName();
 
-    for (int y = 0; y < tmp.height(); y++)
+    if (m_rendered_icon_style != style || m_rendered_icon_theme != icon_theme)
     {
-        QRgb *pixel_ptr = reinterpret_cast<QRgb*>(tmp.scanLine(y));
+        static bool post_routine_added = false;
 
-        for (int x = 0; x < tmp.width(); x++)
+        if (!post_routine_added)
         {
-            QRgb pixel = pixel_ptr[x];
+            qAddPostRoutine(&releaseRenderedIcons);
+            post_routine_added = true;
+        }
 
-            int gray = qGray(pixel);
+        m_rendered_icon_hash.clear();
+        m_rendered_icon_style = style;
+        m_rendered_icon_theme = icon_theme;
+    }
 
-            int alpha = qAlpha(pixel);
+    const QPair<qint64, qreal> key = qMakePair(icon.cacheKey(), pixel_ratio);
 
-            QRgb rgba = qRgba(gray, gray, gray, alpha);
+    if (m_rendered_icon_hash.contains(key))
+        return m_rendered_icon_hash[key];
 
-            pixel_ptr[x] = rgba;
-        }
-    }
+    if (m_rendered_icon_hash.size() >= m_rendered_icon_max_count)
+        m_rendered_icon_hash.clear();
+
+    QGoodWindowStats::Scope stats_scope(qobject_cast<QGoodWindow*>(widget->window()),
+                                        QGoodWindowStats::Counter::IconRasterization);
+
+    const QSize size = QSize(ICONWIDTH, ICONHEIGHT);
+
+    RenderedIcon &rendered = m_rendered_icon_hash[key];
 
-    m_grayed_pixmap = QPixmap::fromImage(tmp);
+    //Render the icon at the window pixel ratio, so painting is a 1:1 blit.
+#ifdef QT_VERSION_QT6
+    rendered.pixmap = icon.pixmap(size, pixel_ratio);
+#else
+    //With Qt::AA_UseHighDpiPixmaps the icon already scales by the application ratio.
+    const qreal app_pixel_ratio = qApp->testAttribute(Qt::AA_UseHighDpiPixmaps) ?
+                qApp->devicePixelRatio() : qreal(1);
 
+    rendered.pixmap = icon.pixmap(size * (pixel_ratio / app_pixel_ratio));
+    rendered.pixmap.setDevicePixelRatio(pixel_ratio);
+#endif
+
+    return rendered;
+}
+}
+
+IconWidget::IconWidget(QWidget *parent) : QWidget(parent)
+{
+    m_active = true;
+    m_pixel_ratio = devicePixelRatioF();
+}
+
+qint64 IconWidget::pixmapBytes() const
+{
+    return QGoodWindow::pixmapBytes(m_pixmap) + QGoodWindow::pixmapBytes(m_grayed_pixmap);
+}
+
+void IconWidget::releaseCachedPixmaps()
+{
+    m_pixmap = QPixmap();
+    m_grayed_pixmap = QPixmap();
+}
+
+void IconWidget::setIcon(const QIcon &icon)
+{
+    m_icon = icon;
+
+    //Rendered or taken from the shared pixmaps on the next paint.
+    releaseCachedPixmaps();
+    update();
+}
+
+void IconWidget::setPixelRatio(qreal pixel_ratio)
+{
+    if (qFuzzyCompare(m_pixel_ratio, pixel_ratio))
+        return;
+
+    m_pixel_ratio = pixel_ratio;
+
+    releaseCachedPixmaps();
     update();
 }
 
+void IconWidget::renderIcon()
+{
+    if (m_icon.isNull())
+        return;
+
+    IconWidgetUtils::RenderedIcon &rendered = IconWidgetUtils::renderedIcon(m_icon, m_pixel_ratio, this);
+
+    //The grayed copy is made on the first inactive paint of any window.
+    if (!m_active && rendered.grayed_pixmap.isNull() && !rendered.pixmap.isNull())
+    {
+        QImage tmp = QGoodImageFilter::grayscaled(rendered.pixmap.toImage());
+        rendered.grayed_pixmap = QPixmap::fromImage(tmp);
+    }
+
+    m_pixmap = rendered.pixmap;
+    m_grayed_pixmap = rendered.grayed_pixmap;
+}
+
 void IconWidget::setActive(bool active)
 {
     m_active = active;
     update();
 }
 
+bool IconWidget::event(QEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::StyleChange:
+    case QEvent::ThemeChange:
+    {
+        //Take the pixmaps rendered for the new style or icon theme on the next paint.
+        releaseCachedPixmaps();
+        update();
+        break;
+    }
+    default:
+        break;
+    }
+
+    return QWidget::event(event);
+}
+
 void IconWidget::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event)
@@ -74,6 +191,11 @@ void IconWidget::paintEvent(QPaintEvent *event)
     if (!isVisible())
         return;
 
+    if (m_pixmap.isNull() || (!m_active && m_grayed_pixmap.isNull()))
+        renderIcon();
+
+    //The target is ICONWIDTH x ICONHEIGHT in logical pixels, a pixmap
+    //rendered at the current pixel ratio is drawn without scaling.
     QPainter painter(this);
     painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
 
@@ -28,6 +28,7 @@ SOFTWARE.
 #include <QtCore>
 #include <QtGui>
 #include <QtWidgets>
+#include <QGoodWindow>
 
 //\cond HIDDEN_SYMBOLS
 class IconWidget : public QWidget
@@ -36,15 +37,27 @@ class IconWidget : public QWidget
 public:
     explicit IconWidget(QWidget *parent = nullptr);
 
+    //Bytes of the rendered icon and it's grayed copy,
+    //which may be shared with the other windows showing the same icon.
+    qint64 pixmapBytes() const;
+
+    //Drops the references to the rendered pixmaps, they are taken again on the next paint.
+    void releaseCachedPixmaps();
+
 public Q_SLOTS:
-    void setPixmap(const QPixmap &pixmap);
+    void setIcon(const QIcon &icon);
+    void setPixelRatio(qreal pixel_ratio);
     void setActive(bool active);
 
 private:
     //Functions
+    void renderIcon();
+    bool event(QEvent *event);
     void paintEvent(QPaintEvent *event);
 
     //Variables
+    QIcon m_icon;
+    qreal m_pixel_ratio;
     QPixmap m_pixmap;
     QPixmap m_grayed_pixmap;
     bool m_active;
@@ -25,8 +25,106 @@ SOFTWARE.
 #include "qgoodcentralwidget.h"
 
 #ifdef QGOODWINDOW
+#include <src/qgoodscheduler.h>
 #include "titlebar.h"
+#include "captionicons.h"
+#include "cornerwidget.h"
 #define BORDERCOLOR QColor(24, 131, 215)
+
+namespace QGoodCentralWidgetUtils
+{
+//Region of a rounded rect of the given size, inset by margins, as rasterized in a bitmap.
+static QRegion rasterizeRoundedRect(const QSize &size, int radius, const QMargins &margins)
+{
+    QBitmap bmp(size);
+    bmp.clear();
+
+    QPainter painter;
+    if (!bmp.isNull() && painter.begin(&bmp))
+    {
+        painter.setRenderHints(QPainter::Antialiasing);
+        painter.setBrush(Qt::color1);
+        painter.drawRoundedRect(QRect(QPoint(0, 0), size).marginsRemoved(margins), radius, radius);
+        painter.end();
+    }
+
+    return QRegion(bmp);
+}
+
+//Region of the given size built from a proxy region of half * 2 pixels square, whose
+//shape only varies near the corners. The corners of the proxy are kept and it's middle
+//column and row are stretched along the edges.
+static QRegion stretchedRegion(const QRegion &proxy, int half, const QSize &size)
+{
+    const int proxy_size = half * 2;
+
+    const int dx = size.width() - proxy_size;
+    const int dy = size.height() - proxy_size;
+
+    QRegion region;
+
+    //Corners.
+    region += proxy.intersected(QRect(0, 0, half, half));
+    region += proxy.intersected(QRect(half, 0, half, half)).translated(dx, 0);
+    region += proxy.intersected(QRect(0, half, half, half)).translated(0, dy);
+    region += proxy.intersected(QRect(half, half, half, half)).translated(dx, dy);
+
+    //Edges, a single column or row of the proxy repeated.
+    const QRegion top = proxy.intersected(QRect(half, 0, 1, half));
+    const QRegion bottom = proxy.intersected(QRect(half, half, 1, half));
+    const QRegion left = proxy.intersected(QRect(0, half, half, 1));
+    const QRegion right = proxy.intersected(QRect(half, half, half, 1));
+
+    for (const QRect &rect : top)
+        region += QRect(half, rect.y(), dx, rect.height());
+
+    for (const QRect &rect : bottom)
+        region += QRect(half, rect.y() + dy, dx, rect.height());
+
+    for (const QRect &rect : left)
+        region += QRect(rect.x(), half, rect.width(), dy);
+
+    for (const QRect &rect : right)
+        region += QRect(rect.x() + dx, half, rect.width(), dy);
+
+    //Interior.
+    if (proxy.contains(QPoint(half, half)))
+        region += QRect(half, half, dx, dy);
+
+    return region;
+}
+
+//Region of a rounded rect of the given size, only a small
+//rounded rect is rasterized and stretched to the final size.
+static QRegion roundedRectRegion(const QSize &size, int radius)
+{
+    const QMargins margins = QMargins(1, 1, 1, 1);
+
+    const int half = radius + 4;
+    const int proxy_size = half * 2;
+
+    if (size.width() < proxy_size || size.height() < proxy_size)
+        return rasterizeRoundedRect(size, radius, margins);
+
+    return stretchedRegion(rasterizeRoundedRect(QSize(proxy_size, proxy_size), radius, margins), half, size);
+}
+
+//Dialog windows built ahead of time, per parent window.
+static QHash<QGoodWindow*, QList<QPointer<QGoodCentralWidget>>> m_dialog_pool_hash;
+static QHash<QGoodWindow*, int> m_dialog_pool_size_hash;
+
+//Delay before each pooled dialog window is built, so the pool doesn't
+//compete with the first paint of the parent or of an opened dialog.
+static const int m_dialog_pool_fill_delay = 250;
+
+//Posted when a title bar widget changes, it's delivered before the event
+//loop waits again, once for all the changes of the current event.
+static QEvent::Type hitMaskEventType()
+{
+    static const QEvent::Type type = QEvent::Type(QEvent::registerEventType());
+    return type;
+}
+}
 #endif
 
 QGoodCentralWidget::QGoodCentralWidget(QGoodWindow *gw) : QWidget(gw)
@@ -38,17 +136,18 @@ QGoodCentralWidget::QGoodCentralWidget(QGoodWindow *gw) : QWidget(gw)
     m_central_widget_place_holder = new QWidget(this);
 
 #ifdef QGOODWINDOW
-    m_update_later_timer = new QTimer(this);
-    connect(m_update_later_timer, &QTimer::timeout, this, &QGoodCentralWidget::updateWindowLater);
-    m_update_later_timer->setSingleShot(true);
-    m_update_later_timer->setInterval(0);
+    m_dirty_flags = 0;
+    m_update_pass_count = 0;
+    m_update_request_count = 0;
+    m_update_batch_level = 0;
+    m_resources_released = false;
+    m_title_bar_widgets_region_dirty = false;
+    m_hit_mask_event_pending = false;
 
     m_left_widget_transparent_for_mouse = false;
     m_right_widget_transparent_for_mouse = false;
     m_center_widget_transparent_for_mouse = false;
 
-    m_frame_style = QString("QFrame#GoodFrame {%0}");
-
     m_active_border_color = BORDERCOLOR;
 
     m_caption_button_width = 36;
@@ -57,6 +156,9 @@ QGoodCentralWidget::QGoodCentralWidget(QGoodWindow *gw) : QWidget(gw)
     m_title_bar->setCaptionButtonWidth(m_caption_button_width);
 
     m_title_bar->installEventFilter(this);
+    m_title_bar->m_left_widget_place_holder->installEventFilter(this);
+    m_title_bar->m_right_widget_place_holder->installEventFilter(this);
+    m_title_bar->m_center_widget_place_holder->installEventFilter(this);
 
     connect(m_gw, &QGoodWindow::captionButtonStateChanged, m_title_bar, &TitleBar::captionButtonStateChanged);
 
@@ -71,14 +173,17 @@ QGoodCentralWidget::QGoodCentralWidget(QGoodWindow *gw) : QWidget(gw)
 
     connect(m_gw, &QGoodWindow::windowIconChanged, m_title_bar, [=](const QIcon &icon){
         if (!icon.isNull())
-        {
-            const int pix_size = 16;
-            m_title_bar->setIcon(icon.pixmap(pix_size, pix_size));
-        }
+            m_title_bar->setIcon(icon);
     });
 
     m_draw_borders = !QGoodWindow::shouldBordersBeDrawnBySystem();
 
+    m_border_cache_radius = -1;
+
+    m_corner_overlay_enabled = false;
+
+    m_central_widget_place_holder->installEventFilter(this);
+
 #ifdef Q_OS_MAC
     connect(m_gw, &QGoodWindow::captionButtonsVisibilityChangedOnMacOS,
             this, &QGoodCentralWidget::updateCaptionButtonsState);
@@ -114,7 +219,22 @@ QGoodCentralWidget::QGoodCentralWidget(QGoodWindow *gw) : QWidget(gw)
 
 QGoodCentralWidget::~QGoodCentralWidget()
 {
+#ifdef QGOODWINDOW
+    QGoodScheduler::cancel(this, QGoodScheduler::Task::UpdatePass);
+    QGoodScheduler::cancel(this, QGoodScheduler::Task::CentralWidgetCorners);
+#endif
+}
+
+QGoodCentralWidget::UpdateScope::UpdateScope(QGoodCentralWidget *gcw) : m_gcw(gcw)
+{
+    if (m_gcw)
+        m_gcw->beginUpdate();
+}
 
+QGoodCentralWidget::UpdateScope::~UpdateScope()
+{
+    if (m_gcw)
+        m_gcw->endUpdate();
 }
 
 int QGoodCentralWidget::execDialogWithWindow(QDialog *dialog, QGoodWindow *parent_gw,
@@ -124,13 +244,78 @@ int QGoodCentralWidget::execDialogWithWindow(QDialog *dialog, QGoodWindow *paren
                                              bool title_visible, bool icon_visible)
 {
 #ifdef QGOODWINDOW
+    QGoodWindow *gw = createDialogWindow(dialog, parent_gw, base_gcw,
+                                         left_title_bar_widget, right_title_bar_widget,
+                                         title_visible, icon_visible);
+
+    return QGoodWindow::execDialog(dialog, gw, parent_gw);
+#else
+    Q_UNUSED(parent_gw)
+    Q_UNUSED(base_gcw)
+    Q_UNUSED(left_title_bar_widget)
+    Q_UNUSED(right_title_bar_widget)
+    Q_UNUSED(title_visible)
+    Q_UNUSED(icon_visible)
+    return dialog->exec();
+#endif
+}
+
+bool QGoodCentralWidget::openDialogWithWindow(QDialog *dialog, QGoodWindow *parent_gw,
+                                              QGoodCentralWidget *base_gcw,
+                                              QWidget *left_title_bar_widget,
+                                              QWidget *right_title_bar_widget,
+                                              bool title_visible, bool icon_visible)
+{
+#ifdef QGOODWINDOW
+    QGoodWindow *gw = createDialogWindow(dialog, parent_gw, base_gcw,
+                                         left_title_bar_widget, right_title_bar_widget,
+                                         title_visible, icon_visible);
+
+    if (!QGoodWindow::openDialog(dialog, gw, parent_gw))
+    {
+        //Give the dialog back to the caller before destroying the unused window.
+        dialog->setParent(nullptr);
+        gw->deleteLater();
+        return false;
+    }
+
+    return true;
+#else
+    Q_UNUSED(base_gcw)
+    Q_UNUSED(left_title_bar_widget)
+    Q_UNUSED(right_title_bar_widget)
+    Q_UNUSED(title_visible)
+    Q_UNUSED(icon_visible)
+    return QGoodWindow::openDialog(dialog, nullptr, parent_gw);
+#endif
+}
+
+#ifdef QGOODWINDOW
+QGoodWindow *QGoodCentralWidget::createDialogWindow(QDialog *dialog, QGoodWindow *parent_gw,
+                                                    QGoodCentralWidget *base_gcw,
+                                                    QWidget *left_title_bar_widget,
+                                                    QWidget *right_title_bar_widget,
+                                                    bool title_visible, bool icon_visible)
+{
     dialog->setWindowFlags(Qt::Widget);
 
-    QGoodWindow *gw = new QGoodWindow(parent_gw);
+    QGoodCentralWidget *gcw = takePooledDialogWindow(parent_gw);
+    QGoodWindow *gw = nullptr;
+
+    if (gcw)
+    {
+        gw = gcw->m_gw;
+    }
+    else
+    {
+        gw = new QGoodWindow(parent_gw);
+        gw->setAttribute(Qt::WA_DeleteOnClose);
+
+        gcw = new QGoodCentralWidget(gw);
+    }
+
     gw->resize(dialog->size());
-    gw->setAttribute(Qt::WA_DeleteOnClose);
 
-    QGoodCentralWidget *gcw = new QGoodCentralWidget(gw);
     gcw->setCentralWidget(dialog);
 
     gcw->setLeftTitleBarWidget(left_title_bar_widget);
@@ -164,15 +349,115 @@ int QGoodCentralWidget::execDialogWithWindow(QDialog *dialog, QGoodWindow *paren
 
     gw->setCentralWidget(gcw);
 
-    return QGoodWindow::execDialog(dialog, gw, parent_gw);
+    return gw;
+}
+#endif
+
+void QGoodCentralWidget::setDialogWindowPoolSize(QGoodWindow *parent_gw, int size)
+{
+#ifdef QGOODWINDOW
+    if (!parent_gw)
+        return;
+
+    size = qMax(size, 0);
+
+    if (!QGoodCentralWidgetUtils::m_dialog_pool_size_hash.contains(parent_gw))
+    {
+        connect(parent_gw, &QObject::destroyed, qApp, [=]{
+            //The pooled windows are children of the parent window and are destroyed with it.
+            QGoodCentralWidgetUtils::m_dialog_pool_hash.remove(parent_gw);
+            QGoodCentralWidgetUtils::m_dialog_pool_size_hash.remove(parent_gw);
+        });
+    }
+
+    QGoodCentralWidgetUtils::m_dialog_pool_size_hash.insert(parent_gw, size);
+
+    QList<QPointer<QGoodCentralWidget>> &pool = QGoodCentralWidgetUtils::m_dialog_pool_hash[parent_gw];
+
+    while (pool.size() > size)
+    {
+        QPointer<QGoodCentralWidget> gcw = pool.takeLast();
+
+        if (gcw && gcw->m_gw)
+            gcw->m_gw->deleteLater();
+    }
+
+    fillDialogWindowPoolLater(parent_gw);
 #else
     Q_UNUSED(parent_gw)
-    Q_UNUSED(base_gcw)
-    Q_UNUSED(left_title_bar_widget)
-    Q_UNUSED(right_title_bar_widget)
-    Q_UNUSED(title_visible)
-    Q_UNUSED(icon_visible)
-    return dialog->exec();
+    Q_UNUSED(size)
+#endif
+}
+
+int QGoodCentralWidget::dialogWindowPoolSize(QGoodWindow *parent_gw)
+{
+#ifdef QGOODWINDOW
+    return QGoodCentralWidgetUtils::m_dialog_pool_size_hash.value(parent_gw, 0);
+#else
+    Q_UNUSED(parent_gw)
+    return 0;
+#endif
+}
+
+void QGoodCentralWidget::fillDialogWindowPoolLater(QGoodWindow *parent_gw)
+{
+#ifdef QGOODWINDOW
+    //Build one window per scheduler wakeup, after the pending paints,
+    //scheduling again replaces the pending fill.
+    QGoodScheduler::schedule(parent_gw, QGoodScheduler::Task::DialogPoolFill,
+                             QGoodCentralWidgetUtils::m_dialog_pool_fill_delay, [=]{
+        const int size = QGoodCentralWidgetUtils::m_dialog_pool_size_hash.value(parent_gw, 0);
+
+        QList<QPointer<QGoodCentralWidget>> &pool = QGoodCentralWidgetUtils::m_dialog_pool_hash[parent_gw];
+
+        pool.removeAll(QPointer<QGoodCentralWidget>());
+
+        if (pool.size() >= size)
+            return;
+
+        QGoodWindow *gw = new QGoodWindow(parent_gw);
+        gw->setAttribute(Qt::WA_DeleteOnClose);
+
+        QGoodCentralWidget *gcw = new QGoodCentralWidget(gw);
+        gw->setCentralWidget(gcw);
+
+        //Native windows are created on the first show, a pooled window
+        //is never shown before being taken, so create it and it's shadow now.
+        gw->createNativeWindow();
+
+        pool.append(gcw);
+
+        if (pool.size() < size)
+            fillDialogWindowPoolLater(parent_gw);
+    });
+#else
+    Q_UNUSED(parent_gw)
+#endif
+}
+
+QGoodCentralWidget *QGoodCentralWidget::takePooledDialogWindow(QGoodWindow *parent_gw)
+{
+#ifdef QGOODWINDOW
+    if (!QGoodCentralWidgetUtils::m_dialog_pool_hash.contains(parent_gw))
+        return nullptr;
+
+    QList<QPointer<QGoodCentralWidget>> &pool = QGoodCentralWidgetUtils::m_dialog_pool_hash[parent_gw];
+
+    QGoodCentralWidget *gcw = nullptr;
+
+    while (!pool.isEmpty() && !gcw)
+        gcw = pool.takeFirst();
+
+    //Replace the window taken from the pool.
+    fillDialogWindowPoolLater(parent_gw);
+
+    if (gcw && !gcw->m_gw)
+        return nullptr;
+
+    return gcw;
+#else
+    Q_UNUSED(parent_gw)
+    return nullptr;
 #endif
 }
 
@@ -224,7 +509,7 @@ void QGoodCentralWidget::setTitleBarMask(const QRegion &mask)
 {
 #ifdef QGOODWINDOW
     m_title_bar_mask = mask;
-    updateWindow();
+    updateWindowMask();
 #else
     Q_UNUSED(mask)
 #endif
@@ -241,7 +526,12 @@ QWidget *QGoodCentralWidget::setLeftTitleBarWidget(QWidget *widget, bool transpa
 
     m_title_bar->setLeftTitleBarWidget(m_title_bar_left_widget);
 
-    updateWindow();
+    untrackTitleBarWidget(return_widget);
+    trackTitleBarWidget(m_title_bar_left_widget);
+
+    updateWindowMask();
+
+    invalidate(UpdateLayout);
 
     return return_widget;
 #else
@@ -262,7 +552,12 @@ QWidget *QGoodCentralWidget::setRightTitleBarWidget(QWidget *widget, bool transp
 
     m_title_bar->setRightTitleBarWidget(m_title_bar_right_widget);
 
-    updateWindow();
+    untrackTitleBarWidget(return_widget);
+    trackTitleBarWidget(m_title_bar_right_widget);
+
+    updateWindowMask();
+
+    invalidate(UpdateLayout);
 
     return return_widget;
 #else
@@ -283,7 +578,12 @@ QWidget *QGoodCentralWidget::setCenterTitleBarWidget(QWidget *widget, bool trans
 
     m_title_bar->setCenterTitleBarWidget(m_title_bar_center_widget);
 
-    updateWindow();
+    untrackTitleBarWidget(return_widget);
+    trackTitleBarWidget(m_title_bar_center_widget);
+
+    updateWindowMask();
+
+    invalidate(UpdateLayout);
 
     return return_widget;
 #else
@@ -307,6 +607,12 @@ void QGoodCentralWidget::setCentralWidget(QWidget *widget)
     layout->setContentsMargins(0, 0, 0, 0);
     layout->setSpacing(0);
     layout->addWidget(m_central_widget);
+
+#ifdef QGOODWINDOW
+    //Keep the corner widgets above the new central widget.
+    if (m_corner_overlay_enabled)
+        updateCentralWidgetCorners();
+#endif
 }
 
 void QGoodCentralWidget::setTitleAlignment(const Qt::Alignment &alignment)
@@ -340,7 +646,7 @@ void QGoodCentralWidget::setActiveBorderColor(const QColor &color)
     else
         m_active_border_color = BORDERCOLOR;
 
-    updateWindow();
+    invalidate(UpdateColors);
 #else
     Q_UNUSED(color)
 #endif
@@ -351,7 +657,7 @@ void QGoodCentralWidget::setTitleBarVisible(bool visible)
 #ifdef QGOODWINDOW
     m_title_bar_visible = visible;
     updateCaptionButtonsState();
-    updateWindow();
+    invalidate(UpdateMask | UpdateLayout);
 #else
     Q_UNUSED(visible)
 #endif
@@ -370,7 +676,7 @@ void QGoodCentralWidget::setCaptionButtonsVisible(bool visible)
         m_gw->setCloseMask(QRegion());
     }
 
-    updateWindow();
+    invalidate(UpdateButtons | UpdateLayout);
 #else
     Q_UNUSED(visible)
 #endif
@@ -381,7 +687,7 @@ void QGoodCentralWidget::setIconVisibility(const IconVisibilityType &type)
 #ifdef QGOODWINDOW
     m_icon_visibility_type = type;
 
-    updateWindow();
+    invalidate(UpdateIcon | UpdateLayout);
 #else
     Q_UNUSED(visible)
 #endif
@@ -394,7 +700,7 @@ void QGoodCentralWidget::setTitleVisible(bool visible)
     m_title_visible = visible;
     m_title_bar->m_title_widget->setVisible(m_title_visible);
     m_title_bar->m_title_widget->setEnabled(m_title_visible);
-    updateWindow();
+    invalidate(UpdateLayout);
 #else
     Q_UNUSED(visible)
 #endif
@@ -417,7 +723,7 @@ void QGoodCentralWidget::setIconWidth(int width)
 {
 #ifdef QGOODWINDOW
     m_gw->setIconWidth(width);
-    updateWindow();
+    invalidate(UpdateIcon | UpdateLayout);
 #else
     Q_UNUSED(width)
 #endif
@@ -429,7 +735,7 @@ void QGoodCentralWidget::setTitleBarHeight(int height)
 #ifdef QGOODWINDOW
     m_title_bar->setFixedHeight(height);
     m_title_bar->setCaptionButtonWidth(m_caption_button_width);
-    updateWindow();
+    invalidate(UpdateMask | UpdateButtons | UpdateLayout);
 #else
     Q_UNUSED(height)
 #endif
@@ -440,12 +746,25 @@ void QGoodCentralWidget::setCaptionButtonWidth(int width)
 #ifdef QGOODWINDOW
     m_caption_button_width = width;
     m_title_bar->setCaptionButtonWidth(m_caption_button_width);
-    updateWindow();
+    invalidate(UpdateButtons | UpdateLayout);
 #else
     Q_UNUSED(width)
 #endif
 }
 
+void QGoodCentralWidget::setCornerOverlayEnabled(bool enabled)
+{
+#ifdef QGOODWINDOW
+    if (m_corner_overlay_enabled == enabled)
+        return;
+
+    m_corner_overlay_enabled = enabled;
+    updateCentralWidgetCorners();
+#else
+    Q_UNUSED(enabled)
+#endif
+}
+
 QGoodCentralWidget::CaptionButtonsType QGoodCentralWidget::captionButtonsType() const
 {
 #ifdef QGOODWINDOW
@@ -600,15 +919,169 @@ int QGoodCentralWidget::captionButtonWidth() const
 #endif
 }
 
+bool QGoodCentralWidget::isCornerOverlayEnabled() const
+{
+#ifdef QGOODWINDOW
+    return m_corner_overlay_enabled;
+#else
+    return false;
+#endif
+}
+
 void QGoodCentralWidget::updateWindow()
 {
 #ifdef QGOODWINDOW
-    updateWindowNow();
-    m_update_later_timer->start();
+    invalidate(UpdateAll);
+#endif
+}
+
+void QGoodCentralWidget::beginUpdate()
+{
+#ifdef QGOODWINDOW
+    m_update_batch_level++;
+#endif
+}
+
+void QGoodCentralWidget::endUpdate()
+{
+#ifdef QGOODWINDOW
+    if (m_update_batch_level <= 0)
+        return;
+
+    m_update_batch_level--;
+
+    if (m_update_batch_level > 0)
+        return;
+
+    if (m_dirty_flags == 0)
+        return;
+
+    QGoodScheduler::cancel(this, QGoodScheduler::Task::UpdatePass);
+
+    updatePendingChanges();
+
+    //Retry on the next event loop iteration if the pass was deferred.
+    if (m_dirty_flags != 0)
+        updateLater();
+#endif
+}
+
+bool QGoodCentralWidget::isUpdating() const
+{
+#ifdef QGOODWINDOW
+    return (m_update_batch_level > 0);
+#else
+    return false;
+#endif
+}
+
+int QGoodCentralWidget::updatePassCount() const
+{
+#ifdef QGOODWINDOW
+    return m_update_pass_count;
+#else
+    return 0;
+#endif
+}
+
+int QGoodCentralWidget::updateRequestCount() const
+{
+#ifdef QGOODWINDOW
+    return m_update_request_count;
+#else
+    return 0;
+#endif
+}
+
+QVariantMap QGoodCentralWidget::footprint() const
+{
+    QVariantMap map;
+
+#ifdef QGOODWINDOW
+    qint64 mask_bytes = QGoodWindow::regionBytes(m_title_bar_mask) +
+            QGoodWindow::regionBytes(m_border_region) +
+            QGoodWindow::regionBytes(m_border_proxy_region) +
+            QGoodWindow::regionBytes(m_central_widget_region);
+
+    for (const QRegion &region : m_title_bar_widget_regions)
+        mask_bytes += QGoodWindow::regionBytes(region);
+
+    mask_bytes += QGoodWindow::regionBytes(m_title_bar_widgets_region);
+
+    map.insert("mask_bytes", mask_bytes);
+    map.insert("pixmap_bytes", m_title_bar ? m_title_bar->m_icon_widget->pixmapBytes() : qint64(0));
+    map.insert("shared_caption_icon_bytes", CaptionIcons::atlasBytes());
+#endif
+
+    return map;
+}
+
+void QGoodCentralWidget::releaseCachedResources()
+{
+#ifdef QGOODWINDOW
+    if (!m_gw)
+        return;
+
+    if (m_gw->isVisible() && !m_gw->isMinimized())
+        return;
+
+    //Everything released here is rebuilt by the update pass
+    //that runs when the window is shown or restored.
+    m_border_cache_radius = -1;
+    m_border_proxy_region = QRegion();
+    m_border_region_size = QSize();
+    m_border_region = QRegion();
+
+    m_central_widget_region_size = QSize();
+    m_central_widget_region = QRegion();
+    m_central_widget_place_holder->clearMask();
+
+    for (auto it = m_title_bar_widget_regions.begin(); it != m_title_bar_widget_regions.end(); ++it)
+        it.value() = QRegion();
+
+    m_title_bar_widgets_region = QRegion();
+    m_title_bar_widgets_region_dirty = false;
+
+    m_title_bar->clearMask();
+    m_title_bar->m_icon_widget->releaseCachedPixmaps();
+
+    m_resources_released = true;
+    m_dirty_flags |= UpdateAll;
+#endif
+}
+
+void QGoodCentralWidget::invalidate(int flags)
+{
+    QGOODWINDOW_TRACE_SCOPE("QGoodCentralWidget::invalidate");
+
+#ifdef QGOODWINDOW
+    //Record what changed and apply everything in one pass
+    //on the next event loop iteration.
+    m_dirty_flags |= flags;
+    m_update_request_count++;
+
+    //Inside a batch update the pass runs on endUpdate.
+    if (m_update_batch_level > 0)
+        return;
+
+    updateLater();
+#else
+    Q_UNUSED(flags)
+#endif
+}
+
+void QGoodCentralWidget::updateLater()
+{
+#ifdef QGOODWINDOW
+    //Keep the pending pass, it already applies all the dirty flags.
+    if (QGoodScheduler::isScheduled(this, QGoodScheduler::Task::UpdatePass))
+        return;
+
+    QGoodScheduler::schedule(this, QGoodScheduler::Task::UpdatePass, 0, [=]{updatePendingChanges();});
 #endif
 }
 
-void QGoodCentralWidget::updateWindowNow()
+void QGoodCentralWidget::updateTitleBarShape()
 {
 #ifdef QGOODWINDOW
 #if defined Q_OS_WIN || defined Q_OS_LINUX
@@ -649,206 +1122,344 @@ void QGoodCentralWidget::updateWindowNow()
 #endif
 }
 
-void QGoodCentralWidget::updateWindowLater()
+void QGoodCentralWidget::updateFrameMargins()
 {
 #ifdef QGOODWINDOW
-    if (!m_gw)
-        return;
+    int border_width = 0;
 
+    if (m_draw_borders && m_gw->windowState().testFlag(Qt::WindowNoState))
+        border_width = 1;
+
+    //Reserve the border area with margins instead of a style sheet,
+    //since the border itself is painted by paintEvent.
+    m_frame->setContentsMargins(border_width, border_width, border_width, border_width);
+#endif
+}
+
+void QGoodCentralWidget::updatePendingChanges()
+{
+    QGOODWINDOW_TRACE_SCOPE("QGoodCentralWidget::updatePendingChanges");
+
+#ifdef QGOODWINDOW
+    if (!m_gw)
+        return;
+
+    //Keep the pending changes until the window is visible again.
     if (!m_gw->isVisible() || m_gw->isMinimized())
         return;
 
-    bool window_active = m_gw->isActiveWindow();
-    bool window_no_state = m_gw->windowState().testFlag(Qt::WindowNoState);
-    bool draw_borders = m_draw_borders;
-    bool is_maximized = m_gw->isMaximized();
-    bool is_full_screen = m_gw->isFullScreen();
-    int icon_width = m_gw->iconWidth();
+    const int flags = m_dirty_flags;
 
-    if (is_full_screen)
-        icon_width = 0;
-    else if (m_icon_visibility_type == IconVisibilityType::IconHidden)
-        icon_width = 0;
-    else if (m_icon_visibility_type == IconVisibilityType::IconOnLeftOfWindow)
-        icon_width = m_title_bar->m_icon_widget->width();
+    if (flags == 0)
+        return;
 
-    QString border_str = "none;";
+    m_dirty_flags = 0;
+    m_update_pass_count++;
 
-    if (draw_borders && window_no_state)
+    QGoodWindowStats::Scope stats_scope(m_gw, QGoodWindowStats::Counter::UpdatePass);
+
+    //The central widget mask has no other trigger on restore.
+    if (m_resources_released)
     {
-        border_str = "border: 1px solid #00000000;";
+        m_resources_released = false;
+        updateCentralWidgetCorners();
     }
-#ifdef Q_OS_WIN
-    else
+
+    bool window_active = m_gw->isActiveWindow();
+    bool is_maximized = m_gw->isMaximized();
+    bool is_full_screen = m_gw->isFullScreen();
+
+    if (flags & UpdateMask)
     {
-        if (window_active)
-            m_gw->setNativeBorderColorOnWindows(m_active_border_color);
-        else
-            m_gw->setNativeBorderColorOnWindows(QColor("#AAAAAA"));
+        updateTitleBarShape();
     }
-#endif
 
-#ifdef Q_OS_LINUX
-    border_str.append("border-radius: 8px;");
+    if (flags & UpdateColors)
+    {
+#ifdef Q_OS_WIN
+        bool window_no_state = m_gw->windowState().testFlag(Qt::WindowNoState);
+
+        if (!(m_draw_borders && window_no_state))
+        {
+            if (window_active)
+                m_gw->setNativeBorderColorOnWindows(m_active_border_color);
+            else
+                m_gw->setNativeBorderColorOnWindows(QColor("#AAAAAA"));
+        }
 #endif
 
-    m_frame->setStyleSheet(m_frame_style.arg(border_str));
+        updateFrameMargins();
 
-    m_title_bar->setMaximized(is_maximized && !is_full_screen);
+        m_title_bar->setActive(window_active);
 
-    m_title_bar->setVisible(m_title_bar_visible && !is_full_screen);
+        //Repaint the border with the current active state.
+        update();
 
-    m_title_bar->setActive(window_active);
+        if (m_corner_overlay_enabled)
+            updateCentralWidgetCorners();
+    }
 
-    m_gw->setIconWidth(icon_width);
+    if (flags & UpdateButtons)
+    {
+        m_title_bar->setMaximized(is_maximized && !is_full_screen);
+    }
 
-    m_title_bar->updateWindow();
+    if (flags & UpdateIcon)
+    {
+        int icon_width = m_gw->iconWidth();
+
+        if (is_full_screen)
+            icon_width = 0;
+        else if (m_icon_visibility_type == IconVisibilityType::IconHidden)
+            icon_width = 0;
+        else if (m_icon_visibility_type == IconVisibilityType::IconOnLeftOfWindow)
+            icon_width = m_title_bar->m_icon_widget->width();
+
+        m_gw->setIconWidth(icon_width);
+    }
 
-    QTimer::singleShot(100, this, &QGoodCentralWidget::updateWindowMask);
+    if (flags & UpdateLayout)
+    {
+        m_title_bar->setVisible(m_title_bar_visible && !is_full_screen);
+    }
+
+    if (flags & (UpdateButtons | UpdateIcon | UpdateLayout))
+    {
+        m_title_bar->updateWindow();
+    }
+
+    if (flags & (UpdateMask | UpdateButtons | UpdateIcon | UpdateLayout))
+    {
+        if (flags & UpdateLayout)
+            refreshTitleBarWidgetRegions();
+
+        updateWindowMask();
+    }
+    else if (flags & UpdateHitMask)
+    {
+        updateHitMask();
+    }
 #endif
 }
 
 void QGoodCentralWidget::updateWindowMask()
 {
+    QGOODWINDOW_TRACE_SCOPE("QGoodCentralWidget::updateWindowMask");
+
 #ifdef QGOODWINDOW
     if (!m_gw)
         return;
 
-    if (!m_gw->isVisible() || m_gw->isMinimized())
+    if (m_update_batch_level > 0)
+    {
+        m_dirty_flags |= UpdateMask;
         return;
+    }
+
+    if (!m_gw->isVisible() || m_gw->isMinimized() || m_gw->isFullScreen())
+        return;
+
+    QGoodWindowStats::Scope stats_scope(m_gw, QGoodWindowStats::Counter::MaskRebuild);
 
-    bool is_full_screen = m_gw->isFullScreen();
     int title_bar_width = m_title_bar->width();
     int title_bar_height = m_title_bar->height();
 
-    if (!is_full_screen)
+    m_gw->setTitleBarHeight(m_title_bar_visible ? title_bar_height : 0);
+
+    updateHitMask();
+
+    if (m_caption_buttons_visible)
     {
-        m_gw->setTitleBarHeight(m_title_bar_visible ? title_bar_height : 0);
+        QRect min_rect = m_title_bar->minimizeButtonRect();
+        QRect max_rect = m_title_bar->maximizeButtonRect();
+        QRect cls_rect = m_title_bar->closeButtonRect();
 
-        QRegion left_mask;
-        QRegion right_mask;
-        QRegion center_mask;
+        min_rect.moveLeft(title_bar_width - cls_rect.width() - max_rect.width() - min_rect.width());
+        max_rect.moveLeft(title_bar_width - cls_rect.width() - max_rect.width());
+        cls_rect.moveLeft(title_bar_width - cls_rect.width());
 
-        if (m_title_bar_left_widget)
-        {
-            QWidgetList list;
+        m_gw->setMinimizeMask(min_rect);
+        m_gw->setMaximizeMask(max_rect);
+        m_gw->setCloseMask(cls_rect);
+    }
+#endif
+}
 
-            if (!m_left_widget_transparent_for_mouse)
-                list.append(m_title_bar_left_widget);
+void QGoodCentralWidget::updateHitMask()
+{
+#ifdef QGOODWINDOW
+    if (!m_gw)
+        return;
 
-            list.append(m_title_bar_left_widget->findChildren<QWidget*>());
+    if (m_update_batch_level > 0)
+    {
+        m_dirty_flags |= UpdateHitMask;
+        return;
+    }
 
-            for (QWidget *widget : list)
-            {
-                if (!widget->testAttribute(Qt::WA_TransparentForMouseEvents))
-                {
-                    if (!widget->mask().isNull())
-                    {
-                        left_mask += widget->mask().translated(m_title_bar->m_left_widget_place_holder->pos());
-                    }
-                    else
-                    {
-                        QRect geom = widget->geometry();
-
-                        if (geom.width() > m_title_bar_left_widget->width())
-                            geom.setWidth(m_title_bar_left_widget->width());
-
-                        left_mask += geom.translated(m_title_bar->m_left_widget_place_holder->pos());
-                    }
-                }
-            }
-        }
+    //Pushed again when the window is shown.
+    if (!m_gw->isVisible() || m_gw->isMinimized() || m_gw->isFullScreen())
+        return;
 
-        if (m_title_bar_right_widget)
-        {
-            QWidgetList list;
+    //Unite the regions once for all the widgets changed since the last push.
+    if (m_title_bar_widgets_region_dirty)
+    {
+        m_title_bar_widgets_region_dirty = false;
+        m_title_bar_widgets_region = QRegion();
 
-            if (!m_right_widget_transparent_for_mouse)
-                list.append(m_title_bar_right_widget);
+        for (auto it = m_title_bar_widget_regions.cbegin(); it != m_title_bar_widget_regions.cend(); ++it)
+            m_title_bar_widgets_region += it.value();
+    }
 
-            list.append(m_title_bar_right_widget->findChildren<QWidget*>());
+    m_gw->setTitleBarMask(m_title_bar_mask + m_title_bar_widgets_region);
+#endif
+}
 
-            for (QWidget *widget : list)
-            {
-                if (!widget->testAttribute(Qt::WA_TransparentForMouseEvents))
-                {
-                    if (!widget->mask().isNull())
-                    {
-                        right_mask += widget->mask().translated(m_title_bar->m_right_widget_place_holder->pos());
-                    }
-                    else
-                    {
-                        QRect geom = widget->geometry();
-
-                        if (geom.width() > m_title_bar_right_widget->width())
-                            geom.setWidth(m_title_bar_right_widget->width());
-
-                        right_mask += geom.translated(m_title_bar->m_right_widget_place_holder->pos());
-                    }
-                }
-            }
-        }
+#ifdef QGOODWINDOW
+void QGoodCentralWidget::updateHitMaskLater()
+{
+    //The title bar shape is unchanged, only the hit test mask is pushed,
+    //at the end of the current event instead of on a later update pass.
+    if (m_hit_mask_event_pending)
+        return;
 
-        if (m_title_bar_center_widget)
-        {
-            QWidgetList list;
+    m_hit_mask_event_pending = true;
+    QCoreApplication::postEvent(this, new QEvent(QGoodCentralWidgetUtils::hitMaskEventType()));
+}
 
-            if (!m_center_widget_transparent_for_mouse)
-                list.append(m_title_bar_center_widget);
+void QGoodCentralWidget::trackTitleBarWidget(QWidget *widget)
+{
+    if (!widget || m_title_bar_widget_regions.contains(widget))
+        return;
 
-            list.append(m_title_bar_center_widget->findChildren<QWidget*>());
+    widget->installEventFilter(this);
 
-            for (QWidget *widget : list)
-            {
-                if (!widget->testAttribute(Qt::WA_TransparentForMouseEvents))
-                {
-                    if (!widget->mask().isNull())
-                    {
-                        center_mask += widget->mask().translated(m_title_bar->m_center_widget_place_holder->pos());
-                    }
-                    else
-                    {
-                        QRect geom = widget->geometry();
-
-                        if (geom.width() > m_title_bar_center_widget->width())
-                            geom.setWidth(m_title_bar_center_widget->width());
-
-                        center_mask += geom.translated(m_title_bar->m_center_widget_place_holder->pos());
-                    }
-                }
-            }
-        }
+    connect(widget, &QObject::destroyed, this, &QGoodCentralWidget::titleBarWidgetDestroyed, Qt::UniqueConnection);
 
-        QRegion title_bar_mask;
+    setTitleBarWidgetRegion(widget, titleBarWidgetRegion(widget));
 
-        if (!m_title_bar_mask.isEmpty())
-            title_bar_mask = m_title_bar_mask;
-        else
-            title_bar_mask -= m_gw->titleBarRect();
+    const QWidgetList children = widget->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly);
 
-        title_bar_mask += left_mask;
-        title_bar_mask += center_mask;
-        title_bar_mask += right_mask;
+    for (QWidget *child : children)
+        trackTitleBarWidget(child);
+}
 
-        m_gw->setTitleBarMask(title_bar_mask);
+void QGoodCentralWidget::untrackTitleBarWidget(QWidget *widget)
+{
+    if (!widget || !m_title_bar_widget_regions.contains(widget))
+        return;
 
-        if (m_caption_buttons_visible)
-        {
-            QRect min_rect = m_title_bar->minimizeButtonRect();
-            QRect max_rect = m_title_bar->maximizeButtonRect();
-            QRect cls_rect = m_title_bar->closeButtonRect();
+    const QWidgetList children = widget->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly);
 
-            min_rect.moveLeft(title_bar_width - cls_rect.width() - max_rect.width() - min_rect.width());
-            max_rect.moveLeft(title_bar_width - cls_rect.width() - max_rect.width());
-            cls_rect.moveLeft(title_bar_width - cls_rect.width());
+    for (QWidget *child : children)
+        untrackTitleBarWidget(child);
 
-            m_gw->setMinimizeMask(min_rect);
-            m_gw->setMaximizeMask(max_rect);
-            m_gw->setCloseMask(cls_rect);
-        }
+    widget->removeEventFilter(this);
+
+    disconnect(widget, &QObject::destroyed, this, &QGoodCentralWidget::titleBarWidgetDestroyed);
+
+    removeTitleBarWidgetRegion(widget);
+}
+
+void QGoodCentralWidget::titleBarWidgetDestroyed(QObject *object)
+{
+    if (!m_title_bar_widget_regions.contains(object))
+        return;
+
+    removeTitleBarWidgetRegion(object);
+    updateHitMaskLater();
+}
+
+QRegion QGoodCentralWidget::titleBarWidgetRegion(QWidget *widget)
+{
+    //Find the title bar widget that contains this widget.
+    QWidget *root = widget;
+
+    while (root && root != m_title_bar_left_widget &&
+           root != m_title_bar_right_widget && root != m_title_bar_center_widget)
+    {
+        root = root->parentWidget();
+    }
+
+    if (!root || !m_title_bar->isAncestorOf(widget))
+        return QRegion();
+
+    bool transparent_for_mouse = false;
+
+    if (root == m_title_bar_left_widget)
+        transparent_for_mouse = m_left_widget_transparent_for_mouse;
+    else if (root == m_title_bar_right_widget)
+        transparent_for_mouse = m_right_widget_transparent_for_mouse;
+    else if (root == m_title_bar_center_widget)
+        transparent_for_mouse = m_center_widget_transparent_for_mouse;
+
+    if (widget == root && transparent_for_mouse)
+        return QRegion();
+
+    if (widget->testAttribute(Qt::WA_TransparentForMouseEvents))
+        return QRegion();
+
+    if (!widget->isVisibleTo(m_title_bar))
+        return QRegion();
+
+    QRegion region = widget->mask().isNull() ? QRegion(widget->rect()) : widget->mask();
+    region.translate(widget->mapTo(m_title_bar, QPoint(0, 0)));
+
+    QRect root_rect = QRect(root->mapTo(m_title_bar, QPoint(0, 0)), root->size());
+
+    return region.intersected(root_rect);
+}
+
+void QGoodCentralWidget::setTitleBarWidgetRegion(QObject *object, const QRegion &region)
+{
+    QRegion &stored_region = m_title_bar_widget_regions[object];
+
+    if (region == stored_region)
+        return;
+
+    //The united region is rebuilt once by the next hit mask push,
+    //no matter how many widgets change before it.
+    stored_region = region;
+    m_title_bar_widgets_region_dirty = true;
+}
+
+void QGoodCentralWidget::removeTitleBarWidgetRegion(QObject *object)
+{
+    if (!m_title_bar_widget_regions.contains(object))
+        return;
+
+    if (!m_title_bar_widget_regions.take(object).isEmpty())
+        m_title_bar_widgets_region_dirty = true;
+}
+
+void QGoodCentralWidget::updateTitleBarWidgetRegion(QWidget *widget)
+{
+    //A change in a widget moves or clips all of it's tracked descendants,
+    //which have no event of their own.
+    setTitleBarWidgetRegion(widget, titleBarWidgetRegion(widget));
+
+    const QWidgetList children = widget->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly);
+
+    for (QWidget *child : children)
+    {
+        if (m_title_bar_widget_regions.contains(child))
+            updateTitleBarWidgetRegion(child);
+    }
+}
+
+void QGoodCentralWidget::refreshTitleBarWidgetRegions()
+{
+    //Catch changes that have no event, like a new widget mask.
+    m_title_bar_widgets_region = QRegion();
+    m_title_bar_widgets_region_dirty = false;
+
+    for (auto it = m_title_bar_widget_regions.begin(); it != m_title_bar_widget_regions.end(); ++it)
+    {
+        it.value() = titleBarWidgetRegion(static_cast<QWidget*>(it.key()));
+        m_title_bar_widgets_region += it.value();
     }
-#endif
 }
+#endif
 
 void QGoodCentralWidget::paintEvent(QPaintEvent *event)
 {
@@ -860,47 +1471,28 @@ void QGoodCentralWidget::paintEvent(QPaintEvent *event)
     bool window_no_state = m_gw->windowState().testFlag(Qt::WindowNoState);
     bool draw_borders = m_draw_borders;
 
-    if (draw_borders)
+    //Borders are only visible in the normal state, otherwise they are fully transparent.
+    if (draw_borders && window_no_state)
     {
-        QColor color = QColor(0, 0, 0, 0);
-
-        if (window_no_state)
-        {
-            color = window_active ? m_active_border_color : QColor("#AAAAAA");
-        }
-
-        QRegion mask;
-
-        if (window_no_state)
-        {
 #ifdef Q_OS_WIN
-            const int radius = 0;
+        const int radius = 0;
 #else
-            const int radius = 8;
+        const int radius = 8;
 #endif
 
-            QBitmap bmp(size());
-            bmp.clear();
+        updateBorderCache(radius);
 
-            QPainter painter;
-            if (!bmp.isNull() && painter.begin(&bmp))
-            {
-                painter.setRenderHints(QPainter::Antialiasing);
-                painter.setBrush(Qt::color1);
-                painter.drawRoundedRect(rect().adjusted(1, 1, -2, -2), radius, radius);
-                painter.end();
-            }
+        //Updates of the interior, like the ones caused by child widgets, don't touch the border.
+        if (!event->region().intersects(m_border_region))
+            return;
 
-            mask = bmp;
-        }
+        QColor color = window_active ? m_active_border_color : QColor("#AAAAAA");
 
         QPainter painter;
         if (painter.begin(this))
         {
-            QPainterPath path;
-            path.addRect(rect());
-            path.addRegion(mask);
-            painter.fillPath(path, color);
+            painter.setClipRegion(event->region().intersected(m_border_region));
+            painter.fillRect(rect(), color);
             painter.end();
         }
     }
@@ -908,6 +1500,42 @@ void QGoodCentralWidget::paintEvent(QPaintEvent *event)
 #endif
 }
 
+#ifdef QGOODWINDOW
+void QGoodCentralWidget::updateBorderCache(int radius)
+{
+    //The border is the area outside of a rounded rect with the right and bottom
+    //edges one pixel further in. It's corners only depend on the radius, so they
+    //are rasterized once per radius and a resize only stretches the edges.
+    const QMargins margins = QMargins(1, 1, 2, 2);
+
+    const int half = radius + 4;
+    const QSize proxy_size = QSize(half * 2, half * 2);
+
+    if (m_border_cache_radius != radius)
+    {
+        m_border_cache_radius = radius;
+
+        m_border_proxy_region = QRegion(QRect(QPoint(0, 0), proxy_size)) -
+                QGoodCentralWidgetUtils::rasterizeRoundedRect(proxy_size, radius, margins);
+
+        m_border_region_size = QSize();
+    }
+
+    if (m_border_region_size == size())
+        return;
+
+    m_border_region_size = size();
+
+    if (width() < proxy_size.width() || height() < proxy_size.height())
+    {
+        m_border_region = QRegion(rect()) - QGoodCentralWidgetUtils::rasterizeRoundedRect(size(), radius, margins);
+        return;
+    }
+
+    m_border_region = QGoodCentralWidgetUtils::stretchedRegion(m_border_proxy_region, half, size());
+}
+#endif
+
 bool QGoodCentralWidget::eventFilter(QObject *watched, QEvent *event)
 {
 #ifdef QGOODWINDOW
@@ -915,13 +1543,28 @@ bool QGoodCentralWidget::eventFilter(QObject *watched, QEvent *event)
     {
         switch (event->type())
         {
+        case QEvent::Polish:
+        {
+            //Reserve the border before the window is shown, so a size
+            //computed from the size hint doesn't change once it's mapped.
+            updateFrameMargins();
+            break;
+        }
         case QEvent::Show:
-        case QEvent::Resize:
         case QEvent::WindowStateChange:
+        {
+            invalidate(UpdateAll);
+            break;
+        }
+        case QEvent::Resize:
+        {
+            invalidate(UpdateMask | UpdateButtons | UpdateLayout);
+            break;
+        }
         case QEvent::WindowActivate:
         case QEvent::WindowDeactivate:
         {
-            updateWindow();
+            invalidate(UpdateColors);
             break;
         }
         default:
@@ -935,7 +1578,107 @@ bool QGoodCentralWidget::eventFilter(QObject *watched, QEvent *event)
         case QEvent::Show:
         case QEvent::Resize:
         {
-            updateWindow();
+            invalidate(UpdateMask | UpdateButtons | UpdateLayout);
+            updateWindowMask();
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    else if (watched == m_central_widget_place_holder)
+    {
+        switch (event->type())
+        {
+        case QEvent::Move:
+        case QEvent::Resize:
+        {
+            //The corner widgets follow the central widget without waiting for the window resize.
+            if (m_corner_overlay_enabled)
+                updateCentralWidgetCorners();
+
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    else if (watched == m_title_bar->m_left_widget_place_holder ||
+             watched == m_title_bar->m_right_widget_place_holder ||
+             watched == m_title_bar->m_center_widget_place_holder)
+    {
+        switch (event->type())
+        {
+        case QEvent::Move:
+        case QEvent::Resize:
+        case QEvent::Show:
+        case QEvent::Hide:
+        {
+            QWidget *widget = nullptr;
+
+            if (watched == m_title_bar->m_left_widget_place_holder)
+                widget = m_title_bar_left_widget;
+            else if (watched == m_title_bar->m_right_widget_place_holder)
+                widget = m_title_bar_right_widget;
+            else
+                widget = m_title_bar_center_widget;
+
+            if (widget)
+            {
+                updateTitleBarWidgetRegion(widget);
+                updateHitMaskLater();
+            }
+
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    else if (m_title_bar_widget_regions.contains(watched))
+    {
+        //Only the region of the changed widget is replaced here, the hit test
+        //mask is pushed once at the end of the current event.
+        switch (event->type())
+        {
+        case QEvent::Move:
+        case QEvent::Resize:
+        case QEvent::Show:
+        case QEvent::Hide:
+        {
+            updateTitleBarWidgetRegion(static_cast<QWidget*>(watched));
+            updateHitMaskLater();
+            break;
+        }
+        case QEvent::ChildAdded:
+        {
+            QObject *child = static_cast<QChildEvent*>(event)->child();
+
+            if (child->isWidgetType())
+            {
+                trackTitleBarWidget(static_cast<QWidget*>(child));
+                updateHitMaskLater();
+            }
+
+            break;
+        }
+        case QEvent::ChildRemoved:
+        {
+            QObject *child = static_cast<QChildEvent*>(event)->child();
+
+            if (m_title_bar_widget_regions.contains(child))
+            {
+                //A child being destroyed is no longer a QWidget here.
+                QWidget *widget = qobject_cast<QWidget*>(child);
+
+                if (widget)
+                    untrackTitleBarWidget(widget);
+                else
+                    removeTitleBarWidgetRegion(child);
+
+                updateHitMaskLater();
+            }
+
             break;
         }
         default:
@@ -949,42 +1692,21 @@ bool QGoodCentralWidget::eventFilter(QObject *watched, QEvent *event)
 bool QGoodCentralWidget::event(QEvent *event)
 {
 #ifdef QGOODWINDOW
+    if (event->type() == QGoodCentralWidgetUtils::hitMaskEventType())
+    {
+        m_hit_mask_event_pending = false;
+        updateHitMask();
+        return true;
+    }
+
 #ifdef Q_OS_LINUX
     switch (event->type())
     {
     case QEvent::Show:
     case QEvent::Resize:
     {
-        QTimer::singleShot(0, this, [=]{
-            if (!m_gw)
-                return;
-
-            if (!m_central_widget_place_holder)
-                return;
-
-            QRegion mask;
-
-            if (m_gw->isVisible() && m_gw->windowState().testFlag(Qt::WindowNoState))
-            {
-                const int radius = 8;
-
-                QBitmap bmp(m_central_widget_place_holder->size());
-                bmp.clear();
-
-                QPainter painter;
-                if (!bmp.isNull() && painter.begin(&bmp))
-                {
-                    painter.setRenderHints(QPainter::Antialiasing);
-                    painter.setBrush(Qt::color1);
-                    painter.drawRoundedRect(m_central_widget_place_holder->rect().adjusted(1, 1, -1, -1), radius, radius);
-                    painter.end();
-                }
-
-                mask = bmp;
-            }
-
-            m_central_widget_place_holder->setMask(mask);
-        });
+        QGoodScheduler::schedule(this, QGoodScheduler::Task::CentralWidgetCorners, 0,
+                                 [=]{updateCentralWidgetCorners();});
 
         break;
     }
@@ -1009,6 +1731,92 @@ bool QGoodCentralWidget::event(QEvent *event)
     return QWidget::event(event);
 }
 
+void QGoodCentralWidget::updateCentralWidgetCorners()
+{
+#ifdef QGOODWINDOW
+#ifdef Q_OS_LINUX
+    if (!m_gw)
+        return;
+
+    if (!m_central_widget_place_holder)
+        return;
+
+    const int radius = 8;
+
+    const bool rounded = m_gw->isVisible() && m_gw->windowState().testFlag(Qt::WindowNoState);
+    const QSize size = m_central_widget_place_holder->size();
+
+    if (rounded && m_central_widget_region_size != size)
+    {
+        m_central_widget_region_size = size;
+        m_central_widget_region = QGoodCentralWidgetUtils::roundedRectRegion(size, radius);
+    }
+
+    if (!m_corner_overlay_enabled)
+    {
+        for (CornerWidget *corner_widget : m_corner_widgets)
+            corner_widget->hide();
+
+        m_central_widget_place_holder->setMask(rounded ? m_central_widget_region : QRegion());
+
+        return;
+    }
+
+    //The central widget paints unclipped, only the pixels outside the
+    //rounded corners are covered by the corner widgets.
+    m_central_widget_place_holder->clearMask();
+
+    if (m_corner_widgets.isEmpty())
+    {
+        for (int i = 0; i < 4; i++)
+            m_corner_widgets.append(new CornerWidget(m_central_widget_place_holder));
+    }
+
+    if (!rounded)
+    {
+        for (CornerWidget *corner_widget : m_corner_widgets)
+            corner_widget->hide();
+
+        return;
+    }
+
+    QRegion border_region;
+
+    if (m_draw_borders)
+    {
+        updateBorderCache(radius);
+        border_region = m_border_region.translated(-m_central_widget_place_holder->mapTo(this, QPoint(0, 0)));
+    }
+
+    const QColor border_color = m_gw->isActiveWindow() ? m_active_border_color : QColor("#AAAAAA");
+
+    const int corner_size = radius + 2;
+
+    const QList<QPoint> corner_pos_list = QList<QPoint>()
+            << QPoint(0, 0)
+            << QPoint(size.width() - corner_size, 0)
+            << QPoint(0, size.height() - corner_size)
+            << QPoint(size.width() - corner_size, size.height() - corner_size);
+
+    for (int i = 0; i < m_corner_widgets.size(); i++)
+    {
+        CornerWidget *corner_widget = m_corner_widgets.at(i);
+        const QRect corner_rect = QRect(corner_pos_list.at(i), QSize(corner_size, corner_size));
+
+        QRegion clear_region = QRegion(corner_rect) - m_central_widget_region;
+        QRegion corner_border_region = border_region.intersected(corner_rect);
+
+        corner_widget->setGeometry(corner_rect);
+        corner_widget->setShape(clear_region.translated(-corner_rect.topLeft()),
+                                corner_border_region.translated(-corner_rect.topLeft()),
+                                border_color);
+        corner_widget->show();
+        corner_widget->raise();
+    }
+#endif
+#endif
+}
+
 void QGoodCentralWidget::updateCaptionButtonsState()
 {
 #ifdef QGOODWINDOW
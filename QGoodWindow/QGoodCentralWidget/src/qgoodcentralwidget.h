@@ -31,6 +31,7 @@ SOFTWARE.
 
 #ifdef QGOODWINDOW
 class TitleBar;
+class CornerWidget;
 #endif
 
 /** **QGoodCentralWidget** class contains the public API's to control the behavior of **QGoodWindow**. */
@@ -54,6 +55,23 @@ public:
                                     QWidget *right_title_bar_widget = nullptr,
                                     bool title_visible = true, bool icon_visible = true);
 
+    /** Same as *execDialogWithWindow*, but returns immediately without a nested event loop.
+        The result is reported by the *dialogFinished* SIGNAL of \e parent_gw.
+        Returns false if the dialog could not be opened. */
+    static bool openDialogWithWindow(QDialog *dialog, QGoodWindow *parent_gw,
+                                     QGoodCentralWidget *base_gcw = nullptr,
+                                     QWidget *left_title_bar_widget = nullptr,
+                                     QWidget *right_title_bar_widget = nullptr,
+                                     bool title_visible = true, bool icon_visible = true);
+
+    /** Keep \e size windows with *QGoodCentralWidget* built ahead of time for *execDialogWithWindow*
+        calls with \e parent_gw as parent, so opening a dialog doesn't pay the window creation.
+        The windows are built one at a time, a moment after the pending paints. Pass 0 to disable, the default. */
+    static void setDialogWindowPoolSize(QGoodWindow *parent_gw, int size);
+
+    /** Returns the number of dialog windows kept built ahead of time for \e parent_gw. */
+    static int dialogWindowPoolSize(QGoodWindow *parent_gw);
+
     /** Types of QGoodCentralWidget caption buttons. */
     enum class CaptionButtonsType
     {
@@ -89,6 +107,24 @@ public:
         IconOnLeftOfTitle
     };
 
+    /** Calls *beginUpdate* on construction and *endUpdate* on destruction. */
+    class QGOODWINDOW_SHARED_EXPORT UpdateScope
+    {
+    public:
+        /** Constructor of *UpdateScope*, starts a batch update on \e gcw. */
+        explicit UpdateScope(QGoodCentralWidget *gcw);
+        /** Destructor of *UpdateScope*, ends the batch update started on construction. */
+        ~UpdateScope();
+
+    private:
+        //\cond HIDDEN_SYMBOLS
+        Q_DISABLE_COPY(UpdateScope)
+
+        //Variables
+        QPointer<QGoodCentralWidget> m_gcw;
+        //\endcond
+    };
+
 public:
     /** Deprecated function, call QGoodWindow *setIconWidth* directly. */
     Q_DECL_DEPRECATED void setIconWidth(int width);
@@ -156,6 +192,10 @@ public Q_SLOTS:
     /** Change the caption button width to \e width multiplied to current pixel ratio. */
     void setCaptionButtonWidth(int width);
 
+    /** Draw the rounded corners of the window on Linux with four small overlay widgets
+        instead of masking the central widget, so the central widget paints unclipped. */
+    void setCornerOverlayEnabled(bool enabled);
+
     /** Returns the caption buttons type. */
     CaptionButtonsType captionButtonsType() const;
 
@@ -201,11 +241,41 @@ public Q_SLOTS:
     /** Returns the *QGoodCentralWidget* title bar caption button width. */
     int captionButtonWidth() const;
 
+    /** Returns if the rounded corners are drawn with overlay widgets instead of masking the central widget. */
+    bool isCornerOverlayEnabled() const;
+
     /** Update the *QGoodCentralWidget* state, it's called internally
         and must be called if changing *QGoodCentralWidget* metrics
         like hide or show a title bar widget. */
     void updateWindow();
 
+    /** Returns the number of update passes run by *QGoodCentralWidget*,
+        all changes requested during an event loop iteration are applied in a single pass. */
+    int updatePassCount() const;
+
+    /** Returns the number of update requests received by *QGoodCentralWidget*. */
+    int updateRequestCount() const;
+
+    /** Returns an estimate of the client side memory held by *QGoodCentralWidget*, in bytes: "mask_bytes" of the
+        masks and cached border shapes and "pixmap_bytes" of the icon. The caption button icons are shared by all
+        windows, their size is reported apart as "shared_caption_icon_bytes". */
+    QVariantMap footprint() const;
+
+    /** Releases the masks, cached border shapes and icon pixmaps, they are rebuilt when the window is shown again.
+        Has no effect while the window is visible and not minimized. Called by *QGoodWindow::releaseCachedResources*. */
+    void releaseCachedResources();
+
+    /** Start a batch update, changes made until the matching *endUpdate* are
+        applied in a single update. Calls may be nested. */
+    void beginUpdate();
+
+    /** End a batch update started with *beginUpdate*, when the outermost batch ends
+        all pending changes are applied immediately. */
+    void endUpdate();
+
+    /** Returns if a batch update started with *beginUpdate* is in progress. */
+    bool isUpdating() const;
+
 protected:
     //\cond HIDDEN_SYMBOLS
     //Functions
@@ -216,27 +286,76 @@ protected:
 
 private:
     //\cond HIDDEN_SYMBOLS
+    //Enums
+    enum UpdateFlag
+    {
+        UpdateMask = 0x01,
+        UpdateColors = 0x02,
+        UpdateButtons = 0x04,
+        UpdateIcon = 0x08,
+        UpdateLayout = 0x10,
+        UpdateHitMask = 0x20,
+        UpdateAll = UpdateMask | UpdateColors | UpdateButtons | UpdateIcon | UpdateLayout | UpdateHitMask
+    };
+
     //Functions
-    void updateWindowNow();
-    void updateWindowLater();
+    static QGoodWindow *createDialogWindow(QDialog *dialog, QGoodWindow *parent_gw,
+                                           QGoodCentralWidget *base_gcw,
+                                           QWidget *left_title_bar_widget,
+                                           QWidget *right_title_bar_widget,
+                                           bool title_visible, bool icon_visible);
+    static void fillDialogWindowPoolLater(QGoodWindow *parent_gw);
+    static QGoodCentralWidget *takePooledDialogWindow(QGoodWindow *parent_gw);
+    void invalidate(int flags);
+    void updateLater();
+    void updatePendingChanges();
+    void updateTitleBarShape();
+    void updateFrameMargins();
     void updateWindowMask();
+    void updateHitMask();
+    void updateHitMaskLater();
+    void trackTitleBarWidget(QWidget *widget);
+    void untrackTitleBarWidget(QWidget *widget);
+    void titleBarWidgetDestroyed(QObject *object);
+    QRegion titleBarWidgetRegion(QWidget *widget);
+    void setTitleBarWidgetRegion(QObject *object, const QRegion &region);
+    void removeTitleBarWidgetRegion(QObject *object);
+    void updateTitleBarWidgetRegion(QWidget *widget);
+    void refreshTitleBarWidgetRegions();
     void updateCaptionButtonsState();
+    void updateBorderCache(int radius);
+    void updateCentralWidgetCorners();
 
     //Variables
     QPointer<QGoodWindow> m_gw;
     QPointer<QWidget> m_central_widget_place_holder;
     QPointer<QWidget> m_central_widget;
 #ifdef QGOODWINDOW
-    QPointer<QTimer> m_update_later_timer;
+    int m_dirty_flags;
+    int m_update_pass_count;
+    int m_update_request_count;
+    int m_update_batch_level;
+    bool m_resources_released;
     bool m_unified_title_bar_and_central_widget;
     QRegion m_title_bar_mask;
+    QHash<QObject*, QRegion> m_title_bar_widget_regions;
+    QRegion m_title_bar_widgets_region;
+    bool m_title_bar_widgets_region_dirty;
+    bool m_hit_mask_event_pending;
     bool m_left_widget_transparent_for_mouse;
     bool m_right_widget_transparent_for_mouse;
     bool m_center_widget_transparent_for_mouse;
     int m_caption_button_width;
     bool m_draw_borders;
+    int m_border_cache_radius;
+    QRegion m_border_proxy_region;
+    QSize m_border_region_size;
+    QRegion m_border_region;
+    bool m_corner_overlay_enabled;
+    QList<CornerWidget*> m_corner_widgets;
+    QSize m_central_widget_region_size;
+    QRegion m_central_widget_region;
     QFrame *m_frame;
-    QString m_frame_style;
     TitleBar *m_title_bar;
     QPointer<QWidget> m_title_bar_left_widget;
     QPointer<QWidget> m_title_bar_right_widget;
@@ -23,38 +23,37 @@ SOFTWARE.
 */
 
 #include "titlebar.h"
+#include <src/qgoodscheduler.h>
+
+namespace TitleBarUtils
+{
+static int m_layout_spacing = -1;
+}
 
 TitleBar::TitleBar(QGoodWindow *gw, QGoodCentralWidget *gcw, QWidget *parent) : QFrame(parent)
 {
-    m_layout_spacing = 0;
+    m_layout = nullptr;
 
     // Get Layout Spacing
+    if (TitleBarUtils::m_layout_spacing < 0)
     {
-        QString old_style;
-
-        if (!qApp->style()->objectName().startsWith("fusion"))
-        {
-            old_style = qApp->style()->objectName();
-            qApp->setStyle(QStyleFactory::create("fusion"));
-        }
-
-        QWidget widget;
-
-        QHBoxLayout *layout = new QHBoxLayout(&widget);
+        //Query the fusion style once per process, instead of swapping the
+        //application style for every title bar.
+        QScopedPointer<QStyle> style(QStyleFactory::create("fusion"));
 
-        m_layout_spacing = layout->spacing();
+        TitleBarUtils::m_layout_spacing = style ? style->pixelMetric(QStyle::PM_LayoutHorizontalSpacing) : 0;
 
-        if (!old_style.isEmpty())
-        {
-            qApp->setStyle(QStyleFactory::create(old_style));
-        }
+        if (TitleBarUtils::m_layout_spacing < 0)
+            TitleBarUtils::m_layout_spacing = 0;
     }
 
+    m_layout_spacing = TitleBarUtils::m_layout_spacing;
+
     m_gw = gw;
 
     m_gcw = gcw;
 
-    m_style = QString("TitleBar {background-color: %0;}");
+    m_pixel_ratio = devicePixelRatioF();
 
     connect(qGoodStateHolder, &QGoodStateHolder::currentThemeChanged, this, &TitleBar::setTheme);
 
@@ -97,18 +96,6 @@ TitleBar::TitleBar(QGoodWindow *gw, QGoodCentralWidget *gcw, QWidget *parent) :
 
     m_caption_buttons->adjustSize();
 
-    QStackedLayout *stacked_layout = new QStackedLayout(this);
-    stacked_layout->setStackingMode(QStackedLayout::StackAll);
-
-    QWidget *widget = new QWidget(this);
-
-    QHBoxLayout *layout = new QHBoxLayout(widget);
-    layout->setContentsMargins(0, 0, 0, 0);
-    layout->setSpacing(0);
-
-    stacked_layout->addWidget(widget);
-    stacked_layout->addWidget(m_title_widget);
-
     m_icon_widget_place_holder = new QWidget(this);
     m_icon_widget_place_holder->setFixedWidth(29);
     m_icon_widget_place_holder->setVisible(false);
@@ -129,19 +116,17 @@ TitleBar::TitleBar(QGoodWindow *gw, QGoodCentralWidget *gcw, QWidget *parent) :
     m_center_widget_place_holder->setVisible(false);
     m_center_widget_place_holder->setEnabled(false);
 
-    m_center_spacer_item_left = new QSpacerItem(0, 0);
-    m_center_spacer_item_right = new QSpacerItem(0, 0);
+    //All slots are placed in a single pass, the title is placed from the resulting slot rects.
+    m_layout = new TitleBarLayout(this);
+    m_layout->setSlotWidget(TitleBarLayout::Slot::LeftMargin, m_left_margin_widget_place_holder);
+    m_layout->setSlotWidget(TitleBarLayout::Slot::Icon, m_icon_widget_place_holder);
+    m_layout->setSlotWidget(TitleBarLayout::Slot::Left, m_left_widget_place_holder);
+    m_layout->setSlotWidget(TitleBarLayout::Slot::Center, m_center_widget_place_holder);
+    m_layout->setSlotWidget(TitleBarLayout::Slot::Right, m_right_widget_place_holder);
+    m_layout->setSlotWidget(TitleBarLayout::Slot::CaptionButtons, m_caption_buttons);
+    m_layout->setSlotWidget(TitleBarLayout::Slot::Title, m_title_widget);
 
-    layout->addWidget(m_left_margin_widget_place_holder);
-    layout->addWidget(m_icon_widget_place_holder);
-    layout->addWidget(m_left_widget_place_holder);
-    layout->addStretch();
-    layout->addSpacerItem(m_center_spacer_item_left);
-    layout->addWidget(m_center_widget_place_holder);
-    layout->addSpacerItem(m_center_spacer_item_right);
-    layout->addStretch();
-    layout->addWidget(m_right_widget_place_holder);
-    layout->addWidget(m_caption_buttons);
+    connect(m_layout, &TitleBarLayout::geometryUpdated, m_title_widget, &TitleWidget::updateLayout);
 
     QTimer::singleShot(0, this, [=]{
         //All caption button starts in hidden state,
@@ -177,9 +162,28 @@ void TitleBar::setTitle(const QString &title)
     m_title_widget->setText(title);
 }
 
-void TitleBar::setIcon(const QPixmap &icon)
+void TitleBar::setIcon(const QIcon &icon)
 {
-    m_icon_widget->setPixmap(icon);
+    m_icon_widget->setIcon(icon);
+}
+
+void TitleBar::updatePixelRatio()
+{
+    qreal pixel_ratio = devicePixelRatioF();
+
+    if (m_gw && m_gw->windowHandle())
+        pixel_ratio = m_gw->windowHandle()->devicePixelRatio();
+
+    if (qFuzzyCompare(m_pixel_ratio, pixel_ratio))
+        return;
+
+    m_pixel_ratio = pixel_ratio;
+
+    m_icon_widget->setPixelRatio(pixel_ratio);
+    m_min_btn->setPixelRatio(pixel_ratio);
+    m_restore_btn->setPixelRatio(pixel_ratio);
+    m_max_btn->setPixelRatio(pixel_ratio);
+    m_cls_btn->setPixelRatio(pixel_ratio);
 }
 
 void TitleBar::setActive(bool active)
@@ -222,21 +226,21 @@ void TitleBar::setMaximized(bool maximized)
 
 void TitleBar::setTheme()
 {
-    bool dark = qGoodStateHolder->isCurrentThemeDark();
+    QGOODWINDOW_TRACE_SCOPE("TitleBar::setTheme");
 
-    setAttribute(Qt::WA_TranslucentBackground, false);
+    bool dark = qGoodStateHolder->isCurrentThemeDark();
 
     if (dark)
     {
-        QTimer::singleShot(0, this, [=]{
+        QGoodScheduler::schedule(this, QGoodScheduler::Task::TitleBarBackground, 0, [=]{
             if (m_title_bar_color == QColor(Qt::transparent))
-                setAttribute(Qt::WA_TranslucentBackground, true);
+                setBackgroundColor(QColor());
             else if (m_title_bar_color.isValid())
-                setStyleSheet(m_style.arg(m_title_bar_color.name()));
+                setBackgroundColor(m_title_bar_color);
             else if (qApp->style()->objectName().startsWith("fusion"))
-                setStyleSheet(m_style.arg(qApp->palette().base().color().name()));
+                setBackgroundColor(qApp->palette().base().color());
             else
-                setStyleSheet(m_style.arg("#000000"));
+                setBackgroundColor(QColor("#000000"));
         });
 
         //Light mode to contrast
@@ -251,15 +255,15 @@ void TitleBar::setTheme()
     }
     else
     {
-        QTimer::singleShot(0, this, [=]{
+        QGoodScheduler::schedule(this, QGoodScheduler::Task::TitleBarBackground, 0, [=]{
             if (m_title_bar_color == QColor(Qt::transparent))
-                setAttribute(Qt::WA_TranslucentBackground, true);
+                setBackgroundColor(QColor());
             else if (m_title_bar_color.isValid())
-                setStyleSheet(m_style.arg(m_title_bar_color.name()));
+                setBackgroundColor(m_title_bar_color);
             else if (qApp->style()->objectName().startsWith("fusion"))
-                setStyleSheet(m_style.arg(qApp->palette().base().color().name()));
+                setBackgroundColor(qApp->palette().base().color());
             else
-                setStyleSheet(m_style.arg("#FFFFFF"));
+                setBackgroundColor(QColor("#FFFFFF"));
         });
 
         //Dark mode to contrast
@@ -274,6 +278,19 @@ void TitleBar::setTheme()
     }
 }
 
+void TitleBar::setBackgroundColor(const QColor &color)
+{
+    //An invalid color means a transparent title bar.
+    setAttribute(Qt::WA_TranslucentBackground, !color.isValid());
+
+    if (m_background_color == color)
+        return;
+
+    m_background_color = color;
+
+    update();
+}
+
 void TitleBar::setLeftTitleBarWidget(QWidget *widget)
 {
     if (m_left_widget_place_holder->layout())
@@ -366,39 +383,6 @@ int TitleBar::captionButtonsWidth()
     return m_caption_buttons->width();
 }
 
-int TitleBar::leftWidth()
-{
-    int left_width = 0;
-
-#ifdef Q_OS_MAC
-    if (m_gw->isNativeCaptionButtonsVisibleOnMac())
-        left_width += m_gw->titleBarButtonsRectOnMacOS().width();
-#endif
-
-    if (m_icon_widget->isVisible())
-        left_width += m_icon_widget->width();
-
-    if (m_left_widget_place_holder)
-        left_width += m_left_widget_place_holder->width();
-
-    return left_width;
-}
-
-int TitleBar::rightWidth()
-{
-    int right_width = 0;
-
-    if (m_caption_buttons->isVisible())
-        right_width += m_caption_buttons->width();
-
-    if (m_right_widget_place_holder->isVisible())
-        right_width += m_right_widget_place_holder->width();
-
-    right_width += layoutSpacing();
-
-    return right_width;
-}
-
 int TitleBar::layoutSpacing()
 {
     return m_layout_spacing;
@@ -494,26 +478,21 @@ void TitleBar::updateIconState()
 
 void TitleBar::updateWindow()
 {
-    int left_width = leftWidth();
-
-    int right_width = rightWidth();
-
-    int distance = right_width - left_width;
-
-    int left_distance = 0;
+    updateIconState();
 
-    int right_distance = 0;
+    //The icon on the left of the title is not a slot of the layout,
+    //but counts on the left side when centering the center widget.
+    int left_balance_width = 0;
 
-    if (distance > 0)
-        left_distance = qAbs(distance);
-    else
-        right_distance = qAbs(distance);
-
-    m_center_spacer_item_left->changeSize(left_distance, 0, QSizePolicy::Preferred, QSizePolicy::Expanding);
+    if (m_gcw->iconVisibility() == QGoodCentralWidget::IconVisibilityType::IconOnLeftOfTitle &&
+            m_icon_widget->isVisible())
+    {
+        left_balance_width = m_icon_widget->width();
+    }
 
-    m_center_spacer_item_right->changeSize(right_distance, 0, QSizePolicy::Preferred, QSizePolicy::Expanding);
+    m_layout->setBalanceWidths(left_balance_width, layoutSpacing());
 
-    updateIconState();
+    m_title_widget->updateLayout();
 }
 
 void TitleBar::captionButtonStateChanged(const QGoodWindow::CaptionButtonState &state)
@@ -637,3 +616,39 @@ void TitleBar::captionButtonStateChanged(const QGoodWindow::CaptionButtonState &
         break;
     }
 }
+
+bool TitleBar::event(QEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::Show:
+    {
+        //Chrome icons are rendered per screen pixel ratio,
+        //render them again when the window moves to another screen.
+        if (m_gw && m_gw->windowHandle())
+        {
+            connect(m_gw->windowHandle(), &QWindow::screenChanged,
+                    this, &TitleBar::updatePixelRatio, Qt::UniqueConnection);
+        }
+
+        updatePixelRatio();
+
+        break;
+    }
+    default:
+        break;
+    }
+
+    return QFrame::event(event);
+}
+
+void TitleBar::paintEvent(QPaintEvent *event)
+{
+    //Paint the background directly instead of using a style sheet,
+    //which would restyle the whole title bar subtree on every change.
+    if (!m_background_color.isValid())
+        return;
+
+    QPainter painter(this);
+    painter.fillRect(event->rect(), m_background_color);
+}
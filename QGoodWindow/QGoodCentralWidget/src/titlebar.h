@@ -33,6 +33,7 @@ SOFTWARE.
 #include "iconwidget.h"
 #include "titlewidget.h"
 #include "captionbutton.h"
+#include "titlebarlayout.h"
 
 //\cond HIDDEN_SYMBOLS
 class TitleBar : public QFrame
@@ -49,7 +50,8 @@ Q_SIGNALS:
 
 public Q_SLOTS:
     void setTitle(const QString &title);
-    void setIcon(const QPixmap &icon);
+    void setIcon(const QIcon &icon);
+    void updatePixelRatio();
     void setActive(bool active);
     void setTitleAlignment(const Qt::Alignment &alignment);
     void setMaximized(bool maximized);
@@ -60,8 +62,6 @@ public Q_SLOTS:
     void setCaptionButtonWidth(int width);
     Qt::Alignment titleAlignment();
     int captionButtonsWidth();
-    int leftWidth();
-    int rightWidth();
     int layoutSpacing();
     bool isMinimizedButtonEnabled();
     bool isMaximizeButtonEnabled();
@@ -74,6 +74,11 @@ public Q_SLOTS:
     void captionButtonStateChanged(const QGoodWindow::CaptionButtonState &state);
 
 private:
+    //Functions
+    void setBackgroundColor(const QColor &color);
+    bool event(QEvent *event);
+    void paintEvent(QPaintEvent *event);
+
     //Variables
     QPointer<QGoodWindow> m_gw;
     QPointer<QGoodCentralWidget> m_gcw;
@@ -92,10 +97,10 @@ private:
     QPointer<QWidget> m_left_widget_place_holder;
     QPointer<QWidget> m_right_widget_place_holder;
     QPointer<QWidget> m_center_widget_place_holder;
-    QSpacerItem *m_center_spacer_item_left;
-    QSpacerItem *m_center_spacer_item_right;
+    TitleBarLayout *m_layout;
     int m_layout_spacing;
-    QString m_style;
+    QColor m_background_color;
+    qreal m_pixel_ratio;
     bool m_active;
     bool m_is_maximized;
     QColor m_title_bar_color;
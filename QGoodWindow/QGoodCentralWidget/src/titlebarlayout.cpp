@@ -0,0 +1,323 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "titlebarlayout.h"
+
+TitleBarLayout::TitleBarLayout(QWidget *parent) : QLayout(parent)
+{
+    m_left_balance_width = 0;
+    m_right_balance_width = 0;
+
+    setContentsMargins(0, 0, 0, 0);
+    setSpacing(0);
+}
+
+TitleBarLayout::~TitleBarLayout()
+{
+    QLayoutItem *item;
+
+    while ((item = takeAt(0)))
+        delete item;
+}
+
+void TitleBarLayout::setSlotWidget(const Slot &slot, QWidget *widget)
+{
+    addChildWidget(widget);
+
+    m_item_list.append(new QWidgetItem(widget));
+    m_slot_list.append(slot);
+
+    invalidate();
+}
+
+void TitleBarLayout::setBalanceWidths(int left_width, int right_width)
+{
+    if (m_left_balance_width == left_width && m_right_balance_width == right_width)
+        return;
+
+    m_left_balance_width = left_width;
+    m_right_balance_width = right_width;
+
+    invalidate();
+}
+
+QRect TitleBarLayout::slotRect(const Slot &slot) const
+{
+    return m_slot_rect_hash.value(int(slot));
+}
+
+void TitleBarLayout::addItem(QLayoutItem *item)
+{
+    //Items without a slot are stacked over the whole title bar.
+    m_item_list.append(item);
+    m_slot_list.append(Slot::Title);
+
+    invalidate();
+}
+
+int TitleBarLayout::count() const
+{
+    return m_item_list.size();
+}
+
+QLayoutItem *TitleBarLayout::itemAt(int index) const
+{
+    return m_item_list.value(index);
+}
+
+QLayoutItem *TitleBarLayout::takeAt(int index)
+{
+    if (index < 0 || index >= m_item_list.size())
+        return nullptr;
+
+    m_slot_list.removeAt(index);
+
+    QLayoutItem *item = m_item_list.takeAt(index);
+
+    invalidate();
+
+    return item;
+}
+
+Qt::Orientations TitleBarLayout::expandingDirections() const
+{
+    return Qt::Horizontal;
+}
+
+QSize TitleBarLayout::sizeHint() const
+{
+    QSize size;
+
+    for (int i = 0; i < m_item_list.size(); i++)
+    {
+        QLayoutItem *item = m_item_list.at(i);
+
+        if (item->isEmpty())
+            continue;
+
+        const QSize item_size = item->sizeHint();
+
+        if (m_slot_list.at(i) != Slot::Title)
+            size.rwidth() += item_size.width();
+
+        size.setHeight(qMax(size.height(), item_size.height()));
+    }
+
+    return size;
+}
+
+QSize TitleBarLayout::minimumSize() const
+{
+    QSize size;
+
+    for (int i = 0; i < m_item_list.size(); i++)
+    {
+        QLayoutItem *item = m_item_list.at(i);
+
+        if (item->isEmpty())
+            continue;
+
+        const QSize item_size = item->minimumSize();
+
+        if (m_slot_list.at(i) != Slot::Title)
+            size.rwidth() += item_size.width();
+
+        size.setHeight(qMax(size.height(), item_size.height()));
+    }
+
+    return size;
+}
+
+void TitleBarLayout::setGeometry(const QRect &rect)
+{
+    QLayout::setGeometry(rect);
+
+    //Place every slot in a single pass: the left slots from the left edge,
+    //the right slots from the right edge and the center slot centered on
+    //the title bar as far as the space between both sides allows.
+    m_slot_rect_hash.clear();
+
+    auto place = [&](const Slot &slot, int x, int width){
+        QLayoutItem *item = slotItem(slot);
+
+        if (!item || item->isEmpty())
+            return;
+
+        const QRect item_rect = QRect(x, rect.top(), width, rect.height());
+
+        m_slot_rect_hash.insert(int(slot), item_rect);
+        item->setGeometry(item_rect);
+    };
+
+    //Slots are shrunk in this order when there is not enough space,
+    //the caption buttons are kept as long as possible.
+    const QList<Slot> shrink_slot_list = QList<Slot>()
+            << Slot::Center << Slot::Left << Slot::Right
+            << Slot::Icon << Slot::LeftMargin << Slot::CaptionButtons;
+
+    QHash<int, int> width_hash;
+
+    int hint_width = 0;
+    int shrinkable_width = 0;
+
+    for (const Slot &slot : shrink_slot_list)
+    {
+        const int width = slotWidth(slot);
+
+        width_hash.insert(int(slot), width);
+
+        hint_width += width;
+        shrinkable_width += width - slotMinimumWidth(slot);
+    }
+
+    int shortfall = hint_width - rect.width();
+
+    //Spread the shortfall across the slots that can shrink, in proportion
+    //to how much each one can shrink, down to their minimum widths.
+    if (shortfall > 0 && shrinkable_width > 0)
+    {
+        const int shrink_width = qMin(shortfall, shrinkable_width);
+
+        int remaining_width = shrink_width;
+
+        for (const Slot &slot : shrink_slot_list)
+        {
+            const int slot_shrinkable_width = width_hash.value(int(slot)) - slotMinimumWidth(slot);
+            const int slot_shrink_width = int(qint64(shrink_width) * slot_shrinkable_width / shrinkable_width);
+
+            width_hash[int(slot)] -= slot_shrink_width;
+            remaining_width -= slot_shrink_width;
+        }
+
+        //Pixels left by the rounding.
+        for (const Slot &slot : shrink_slot_list)
+        {
+            const int slot_shrink_width = qMin(remaining_width, width_hash.value(int(slot)) - slotMinimumWidth(slot));
+
+            width_hash[int(slot)] -= slot_shrink_width;
+            remaining_width -= slot_shrink_width;
+        }
+
+        shortfall -= shrink_width;
+    }
+
+    //Narrower than the minimum widths, cut the slots in order
+    //so they never overlap or leave the title bar.
+    for (const Slot &slot : shrink_slot_list)
+    {
+        if (shortfall <= 0)
+            break;
+
+        const int slot_shrink_width = qMin(shortfall, width_hash.value(int(slot)));
+
+        width_hash[int(slot)] -= slot_shrink_width;
+        shortfall -= slot_shrink_width;
+    }
+
+    const int left_margin_width = width_hash.value(int(Slot::LeftMargin));
+    const int icon_width = width_hash.value(int(Slot::Icon));
+    const int left_width = width_hash.value(int(Slot::Left));
+    const int center_width = width_hash.value(int(Slot::Center));
+    const int right_width = width_hash.value(int(Slot::Right));
+    const int caption_buttons_width = width_hash.value(int(Slot::CaptionButtons));
+
+    int left = rect.left();
+
+    place(Slot::LeftMargin, left, left_margin_width);
+    left += left_margin_width;
+
+    place(Slot::Icon, left, icon_width);
+    left += icon_width;
+
+    place(Slot::Left, left, left_width);
+    left += left_width;
+
+    int right = rect.left() + rect.width();
+
+    right -= caption_buttons_width;
+    place(Slot::CaptionButtons, right, caption_buttons_width);
+
+    right -= right_width;
+    place(Slot::Right, right, right_width);
+
+    //Offset the center slot by the difference of both sides, so it's centered on
+    //the title bar. The offset shrinks first when there is not enough space.
+    const int left_side_width = left_margin_width + icon_width + left_width + m_left_balance_width;
+    const int right_side_width = right_width + caption_buttons_width + m_right_balance_width;
+
+    const int distance = right_side_width - left_side_width;
+
+    int left_distance = qMax(distance, 0);
+    int right_distance = qMax(-distance, 0);
+
+    const int free_width = right - left - center_width;
+    const int extra_width = free_width - left_distance - right_distance;
+
+    if (extra_width >= 0)
+    {
+        left_distance += extra_width / 2;
+    }
+    else if (left_distance + right_distance > 0)
+    {
+        left_distance = qMax(free_width, 0) * left_distance / (left_distance + right_distance);
+    }
+
+    place(Slot::Center, left + left_distance, center_width);
+
+    for (int i = 0; i < m_item_list.size(); i++)
+    {
+        if (m_slot_list.at(i) == Slot::Title && !m_item_list.at(i)->isEmpty())
+            m_item_list.at(i)->setGeometry(rect);
+    }
+
+    Q_EMIT geometryUpdated();
+}
+
+QLayoutItem *TitleBarLayout::slotItem(const Slot &slot) const
+{
+    const int index = m_slot_list.indexOf(slot);
+
+    return m_item_list.value(index);
+}
+
+int TitleBarLayout::slotWidth(const Slot &slot) const
+{
+    QLayoutItem *item = slotItem(slot);
+
+    if (!item || item->isEmpty())
+        return 0;
+
+    return item->sizeHint().width();
+}
+
+int TitleBarLayout::slotMinimumWidth(const Slot &slot) const
+{
+    QLayoutItem *item = slotItem(slot);
+
+    if (!item || item->isEmpty())
+        return 0;
+
+    //The minimum size of a widget item already follows the size policy.
+    return qMin(item->minimumSize().width(), item->sizeHint().width());
+}
@@ -0,0 +1,83 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef TITLEBARLAYOUT_H
+#define TITLEBARLAYOUT_H
+
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+
+//\cond HIDDEN_SYMBOLS
+class TitleBarLayout : public QLayout
+{
+    Q_OBJECT
+public:
+    enum class Slot
+    {
+        LeftMargin,
+        Icon,
+        Left,
+        Center,
+        Right,
+        CaptionButtons,
+        Title
+    };
+
+    explicit TitleBarLayout(QWidget *parent = nullptr);
+    ~TitleBarLayout();
+
+    //Functions
+    void setSlotWidget(const Slot &slot, QWidget *widget);
+    void setBalanceWidths(int left_width, int right_width);
+    QRect slotRect(const Slot &slot) const;
+
+    void addItem(QLayoutItem *item);
+    int count() const;
+    QLayoutItem *itemAt(int index) const;
+    QLayoutItem *takeAt(int index);
+    Qt::Orientations expandingDirections() const;
+    QSize sizeHint() const;
+    QSize minimumSize() const;
+    void setGeometry(const QRect &rect);
+
+Q_SIGNALS:
+    void geometryUpdated();
+
+private:
+    //Functions
+    QLayoutItem *slotItem(const Slot &slot) const;
+    int slotWidth(const Slot &slot) const;
+    int slotMinimumWidth(const Slot &slot) const;
+
+    //Variables
+    QList<QLayoutItem*> m_item_list;
+    QList<Slot> m_slot_list;
+    QHash<int, QRect> m_slot_rect_hash;
+    int m_left_balance_width;
+    int m_right_balance_width;
+};
+//\endcond
+
+#endif // TITLEBARLAYOUT_H
@@ -25,18 +25,28 @@ SOFTWARE.
 #include "titlewidget.h"
 #include "titlebar.h"
 
-TitleWidget::TitleWidget(TitleBar *title_bar, QWidget *parent) : QWidget(parent)
+TitleWidget::TitleWidget(TitleBar *title_bar, QWidget *parent) : QWidget(parent),
+    m_title_metrics(QFont())
 {
     m_title_bar = title_bar;
 
     m_active = false;
     m_alignment = Qt::AlignLeft;
+
+    m_elided_title_width = -1;
+
+    m_static_text.setTextFormat(Qt::PlainText);
+
+    //Only keep the font here, the title bar is still being built,
+    //the title is placed on its first layout pass.
+    m_title_font = titleFont();
+    m_title_metrics = QFontMetrics(m_title_font);
 }
 
 void TitleWidget::setText(const QString &text)
 {
     m_title = text;
-    update();
+    updateLayout();
 }
 
 void TitleWidget::setActive(bool active)
@@ -63,7 +73,7 @@ void TitleWidget::setTitleAlignment(const Qt::Alignment &alignment)
     }
     }
 
-    update();
+    updateLayout();
 }
 
 void TitleWidget::setTitleColor(const QColor &active_color, const QColor &inactive_color)
@@ -81,7 +91,27 @@ Qt::Alignment TitleWidget::titleAlignment()
 
 int TitleWidget::leftPos()
 {
-    return titleRect().left();
+    return m_title_rect.left();
+}
+
+void TitleWidget::updateLayout()
+{
+    //Place the title and the icon outside of paintEvent, since moving
+    //or hiding the icon while painting would schedule more paints.
+    //Repaint only when the result changes.
+    if (!m_title_bar)
+        return;
+
+    QString title_elided;
+    QRect title_rect = titleRect(&title_elided);
+
+    if (title_rect == m_title_rect && title_elided == m_title_rect_text)
+        return;
+
+    m_title_rect = title_rect;
+    m_title_rect_text = title_elided;
+
+    update();
 }
 
 QFont TitleWidget::titleFont()
@@ -94,40 +124,89 @@ QFont TitleWidget::titleFont()
     return font;
 }
 
+void TitleWidget::updateTitleFont()
+{
+    QFont font = titleFont();
+
+    if (font == m_title_font)
+        return;
+
+    m_title_font = font;
+    m_title_metrics = QFontMetrics(m_title_font);
+
+    //Invalidate the elided title layout.
+    m_elided_title_width = -1;
+
+    //Force a repaint even if the title geometry is the same.
+    m_title_rect_text.clear();
+
+    updateLayout();
+}
+
+QString TitleWidget::elidedTitle(int width, QSize *title_size_ptr)
+{
+    //Eliding and measuring are only done when the title, the available width or the font changes.
+    if (width != m_elided_title_width || m_title != m_elided_title_source)
+    {
+        m_elided_title_source = m_title;
+        m_elided_title_width = width;
+
+        m_elided_title = m_title_metrics.elidedText(m_title, Qt::ElideRight, width);
+        m_elided_title_size = m_title_metrics.size(0, m_elided_title);
+
+        m_static_text.setText(m_elided_title);
+        m_static_text.prepare(QTransform(), m_title_font);
+    }
+
+    if (title_size_ptr)
+        *title_size_ptr = m_elided_title_size;
+
+    return m_elided_title;
+}
+
 QRect TitleWidget::titleRect(QString *title_elided_ptr)
 {
+    //The slot rects come from the last title bar layout pass,
+    //hidden slots have null rects.
+    const TitleBarLayout *layout = m_title_bar->m_layout;
+
+    //The title bar is still being built.
+    if (!layout)
+    {
+        if (title_elided_ptr)
+            title_elided_ptr->clear();
+
+        return QRect();
+    }
+
     const int spacing = m_title_bar->layoutSpacing();
 
+    const QRect caption_buttons_rect = layout->slotRect(TitleBarLayout::Slot::CaptionButtons);
+
     QRect left_rect;
     QRect right_rect;
     QRect center_rect;
 
     left_rect = left_rect.united(QRect(m_title_bar->m_gw->iconWidth(), 0, 1, height()));
+    left_rect = left_rect.united(layout->slotRect(TitleBarLayout::Slot::LeftMargin));
+    left_rect = left_rect.united(layout->slotRect(TitleBarLayout::Slot::Left));
 
-    if (m_title_bar->m_left_margin_widget_place_holder->isVisible())
-        left_rect = left_rect.united(m_title_bar->m_left_margin_widget_place_holder->geometry());
-    if (m_title_bar->m_left_widget_place_holder->isVisible())
-        left_rect = left_rect.united(m_title_bar->m_left_widget_place_holder->geometry());
+    right_rect = right_rect.united(layout->slotRect(TitleBarLayout::Slot::Right));
 
-    if (m_title_bar->m_right_widget_place_holder->isVisible())
-        right_rect = right_rect.united(m_title_bar->m_right_widget_place_holder->geometry());
-    if (m_title_bar->m_caption_buttons->isVisible())
-        right_rect = right_rect.united(m_title_bar->m_caption_buttons->geometry());
+    if (!caption_buttons_rect.isNull())
+        right_rect = right_rect.united(caption_buttons_rect);
     else
         right_rect = right_rect.united(QRect(width(), 0, 1, height()));
 
-    if (m_title_bar->m_center_widget_place_holder->isVisible())
-        center_rect = center_rect.united(m_title_bar->m_center_widget_place_holder->geometry());
+    center_rect = layout->slotRect(TitleBarLayout::Slot::Center);
 
-    bool center_widget_visible = m_title_bar->m_center_widget_place_holder->isVisible();
+    bool center_widget_visible = !center_rect.isNull();
 
     Qt::Alignment alignment = m_alignment;
 
     if (center_widget_visible && alignment == Qt::AlignCenter)
         alignment = Qt::AlignLeft;
 
-    QFontMetrics metrics(titleFont());
-
     int title_space_width;
 
     if (center_widget_visible)
@@ -173,9 +252,9 @@ QRect TitleWidget::titleRect(QString *title_elided_ptr)
 
     int title_width_minus_icon = title_space_width - spacing - (icon_on_left_of_title ? icon->width() : 0);
 
-    QString title_elided = metrics.elidedText(m_title, Qt::ElideRight, title_width_minus_icon);
+    QSize title_size;
 
-    QSize title_size = metrics.size(0, title_elided);
+    QString title_elided = elidedTitle(title_width_minus_icon, &title_size);
 
     int title_width = title_size.width();
     int title_height = title_size.height();
@@ -275,6 +354,28 @@ QRect TitleWidget::titleRect(QString *title_elided_ptr)
     return title_rect;
 }
 
+bool TitleWidget::event(QEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::FontChange:
+    case QEvent::ApplicationFontChange:
+    {
+        updateTitleFont();
+        break;
+    }
+    case QEvent::Resize:
+    {
+        updateLayout();
+        break;
+    }
+    default:
+        break;
+    }
+
+    return QWidget::event(event);
+}
+
 void TitleWidget::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event)
@@ -282,15 +383,13 @@ void TitleWidget::paintEvent(QPaintEvent *event)
     QPainter painter(this);
     painter.setRenderHints(QPainter::Antialiasing);
 
-    painter.setFont(titleFont());
+    painter.setFont(m_title_font);
 
     QPen pen;
     pen.setColor(m_active ? m_active_color : m_inactive_color);
 
     painter.setPen(pen);
 
-    QString title_elided;
-    QRect rect = titleRect(&title_elided);
-
-    painter.drawText(rect, title_elided);
+    //The static text keeps the glyph layout of the elided title between paints.
+    painter.drawStaticText(m_title_rect.topLeft(), m_static_text);
 }
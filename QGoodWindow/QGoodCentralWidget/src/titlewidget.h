@@ -45,11 +45,15 @@ public Q_SLOTS:
     void setTitleColor(const QColor &active_color, const QColor &inactive_color);
     Qt::Alignment titleAlignment();
     int leftPos();
+    void updateLayout();
 
 private:
     //Functions
     QFont titleFont();
+    void updateTitleFont();
+    QString elidedTitle(int width, QSize *title_size_ptr = nullptr);
     QRect titleRect(QString *title_elided_ptr = nullptr);
+    bool event(QEvent *event);
     void paintEvent(QPaintEvent *event);
 
     //Variables
@@ -59,6 +63,15 @@ private:
     Qt::Alignment m_alignment;
     QColor m_active_color;
     QColor m_inactive_color;
+    QFont m_title_font;
+    QFontMetrics m_title_metrics;
+    QString m_elided_title;
+    QString m_elided_title_source;
+    int m_elided_title_width;
+    QSize m_elided_title_size;
+    QStaticText m_static_text;
+    QRect m_title_rect;
+    QString m_title_rect_text;
 };
 //\endcond
 
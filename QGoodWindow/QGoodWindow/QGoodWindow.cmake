@@ -23,6 +23,10 @@
 target_sources(${PROJECT_NAME} PRIVATE
     ${CMAKE_CURRENT_LIST_DIR}/src/qgoodwindow.cpp ${CMAKE_CURRENT_LIST_DIR}/src/qgoodwindow.h
     ${CMAKE_CURRENT_LIST_DIR}/src/qgoodstateholder.cpp ${CMAKE_CURRENT_LIST_DIR}/src/qgoodstateholder.h
+    ${CMAKE_CURRENT_LIST_DIR}/src/qgoodimagefilter.cpp ${CMAKE_CURRENT_LIST_DIR}/src/qgoodimagefilter.h
+    ${CMAKE_CURRENT_LIST_DIR}/src/qgoodtrace.cpp ${CMAKE_CURRENT_LIST_DIR}/src/qgoodtrace.h
+    ${CMAKE_CURRENT_LIST_DIR}/src/qgoodwindowstats.cpp ${CMAKE_CURRENT_LIST_DIR}/src/qgoodwindowstats.h
+    ${CMAKE_CURRENT_LIST_DIR}/src/qgoodscheduler.cpp ${CMAKE_CURRENT_LIST_DIR}/src/qgoodscheduler.h
     ${CMAKE_CURRENT_LIST_DIR}/src/lightstyle.cpp ${CMAKE_CURRENT_LIST_DIR}/src/lightstyle.h
     ${CMAKE_CURRENT_LIST_DIR}/src/darkstyle.cpp ${CMAKE_CURRENT_LIST_DIR}/src/darkstyle.h
     ${CMAKE_CURRENT_LIST_DIR}/src/stylecommon.cpp ${CMAKE_CURRENT_LIST_DIR}/src/stylecommon.h
@@ -39,6 +43,12 @@ target_compile_definitions(${PROJECT_NAME} PUBLIC
     UNICODE
 )
 
+if(qgoodwindow_trace) #This flag enable the trace points
+    target_compile_definitions(${PROJECT_NAME} PUBLIC
+        QGOODWINDOW_TRACE
+    )
+endif()
+
 if(WIN32 AND ${QT_VERSION_MAJOR} EQUAL 5)
     find_package(Qt5 REQUIRED
         WinExtras
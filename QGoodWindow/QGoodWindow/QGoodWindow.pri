@@ -31,6 +31,10 @@ CONFIG += c++11
 SOURCES += \
     $$PWD/src/qgoodwindow.cpp \
     $$PWD/src/qgoodstateholder.cpp \
+    $$PWD/src/qgoodimagefilter.cpp \
+    $$PWD/src/qgoodtrace.cpp \
+    $$PWD/src/qgoodwindowstats.cpp \
+    $$PWD/src/qgoodscheduler.cpp \
     $$PWD/src/lightstyle.cpp \
     $$PWD/src/darkstyle.cpp \
     $$PWD/src/stylecommon.cpp
@@ -38,6 +42,10 @@ SOURCES += \
 HEADERS += \
     $$PWD/src/qgoodwindow.h \
     $$PWD/src/qgoodstateholder.h \
+    $$PWD/src/qgoodimagefilter.h \
+    $$PWD/src/qgoodtrace.h \
+    $$PWD/src/qgoodwindowstats.h \
+    $$PWD/src/qgoodscheduler.h \
     $$PWD/src/intcommon.h \
     $$PWD/src/lightstyle.h \
     $$PWD/src/darkstyle.h \
@@ -59,6 +67,10 @@ win32 {
 LIBS += -lUser32 -lGdi32
 }
 
+qgoodwindow_trace { #This flag enable the trace points
+DEFINES += QGOODWINDOW_TRACE
+}
+
 !no_qgoodwindow{
 
 win32 { #Windows
@@ -25,6 +25,7 @@ SOFTWARE.
 
 #include "darkstyle.h"
 #include "stylecommon.h"
+#include "qgoodwindowstats.h"
 
 DarkStyle::DarkStyle() : DarkStyle(styleBase())
 {
@@ -115,6 +116,7 @@ void DarkStyle::polish(QApplication *app)
     if (file.open(QFile::ReadOnly | QFile::Text))
     {
         QString style_sheet = QLatin1String(file.readAll());
+        QGoodWindowStats::Scope stats_scope(nullptr, QGoodWindowStats::Counter::StyleSheetApply);
         app->setStyleSheet(style_sheet);
         file.close();
     }
@@ -25,6 +25,7 @@ SOFTWARE.
 
 #include "lightstyle.h"
 #include "stylecommon.h"
+#include "qgoodwindowstats.h"
 
 LightStyle::LightStyle() : LightStyle(styleBase())
 {
@@ -115,6 +116,7 @@ void LightStyle::polish(QApplication *app)
     if (file.open(QIODevice::ReadOnly | QIODevice::Text))
     {
         QString style_sheet = QString::fromLatin1(file.readAll());
+        QGoodWindowStats::Scope stats_scope(nullptr, QGoodWindowStats::Counter::StyleSheetApply);
         app->setStyleSheet(style_sheet);
         file.close();
     }
@@ -38,12 +38,12 @@ Notification::~Notification()
 
 void Notification::addWindow(void *ptr)
 {
-    m_ptr_list.append(ptr);
+    m_ptr_list.insert(ptr);
 }
 
 void Notification::removeWindow(void *ptr)
 {
-    m_ptr_list.removeAll(ptr);
+    m_ptr_list.remove(ptr);
 }
 
 void Notification::registerNotification(const QByteArray &name, WId wid)
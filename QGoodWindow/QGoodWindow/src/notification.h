@@ -42,7 +42,7 @@ public:
     void unregisterNotification();
 
 private:
-    QList<void*> m_ptr_list;
+    QSet<void*> m_ptr_list;
 };
 //\endcond
 
@@ -35,7 +35,8 @@ SOFTWARE.
 
 namespace QGoodDialogUtils
 {
-static bool m_dialog_is_visible = false;
+//Open dialogs, the last one is the top most.
+static QList<QGoodDialog*> m_dialog_stack;
 }
 
 QGoodDialog::QGoodDialog(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow *parent_gw) : QObject()
@@ -46,6 +47,12 @@ QGoodDialog::QGoodDialog(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow *pa
 
     m_parent_gw = parent_gw;
 
+    m_async = false;
+
+    m_finished = false;
+
+    m_result = QDialog::Rejected;
+
 #ifdef Q_OS_MAC
     m_child_gw_visible = false;
 #endif
@@ -53,19 +60,42 @@ QGoodDialog::QGoodDialog(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow *pa
 
 int QGoodDialog::exec()
 {
-    if (!m_dialog)
+    QGOODWINDOW_TRACE_SCOPE("QGoodDialog::exec");
+
+    if (!start())
         return QDialog::Rejected;
 
+    m_loop.exec();
+
+    finish();
+
+    return m_result;
+}
+
+bool QGoodDialog::start()
+{
+    if (!m_dialog)
+        return false;
+
     if (!m_child_gw)
-        return QDialog::Rejected;
+        return false;
 
     if (!m_parent_gw)
-        return QDialog::Rejected;
+        return false;
 
-    if (QGoodDialogUtils::m_dialog_is_visible)
-        return QDialog::Rejected;
+    //Any number of dialogs may be stacked, but each dialog is shown once.
+    for (QGoodDialog *good_dialog : QGoodDialogUtils::m_dialog_stack)
+    {
+        if (good_dialog->m_dialog == m_dialog || good_dialog->m_child_gw == m_child_gw)
+            return false;
+    }
 
-    QGoodDialogUtils::m_dialog_is_visible = true;
+    QGoodDialogUtils::m_dialog_stack.append(this);
+
+    //The windows may be destroyed without a Close event, like a parent
+    //deleted with the dialog open, finish then so nothing stays blocked.
+    connect(m_child_gw, &QObject::destroyed, this, &QGoodDialog::finish);
+    connect(m_parent_gw, &QObject::destroyed, this, &QGoodDialog::finish);
 
     m_child_gw->installEventFilter(this);
 
@@ -168,6 +198,7 @@ int QGoodDialog::exec()
 
     QTimer::singleShot(0, m_child_gw, [=]{
 #ifdef Q_OS_WIN
+        m_child_gw->createNativeWindow();
         if (m_child_gw->m_shadow)
             m_child_gw->m_shadow->showLater();
         m_child_gw->m_main_window->show();
@@ -180,23 +211,96 @@ int QGoodDialog::exec()
         func_center();
 #endif
 #ifdef Q_OS_LINUX
+        //Polish and lay out the window before computing its size, so the final
+        //geometry is known before the window is mapped, and the window manager
+        //places it once instead of mapping it and configuring it again.
+        m_child_gw->ensurePolished();
+
+        if (m_child_gw->layout())
+            m_child_gw->layout()->activate();
+
         func_fixed_size();
         func_center();
         m_child_gw->show();
-        func_fixed_size();
-        func_center();
 #endif
     });
 #endif
 
-    m_loop.exec();
+    return true;
+}
+
+void QGoodDialog::finish()
+{
+    if (m_finished)
+        return;
+
+    m_finished = true;
+
+    m_loop.quit();
+
+    QGoodDialogUtils::m_dialog_stack.removeAll(this);
+
+    unblockWindows();
+
+    if (m_dialog)
+    {
+        m_result = m_dialog->result();
+        m_dialog->setParent(nullptr);
+    }
+
+    if (m_child_gw)
+        m_child_gw->setParent(nullptr);
+
+    if (m_async)
+    {
+        if (m_parent_gw)
+            Q_EMIT m_parent_gw->dialogFinished(m_dialog, m_result);
+
+        deleteLater();
+    }
+}
+
+void QGoodDialog::unblockWindows()
+{
+#if defined Q_OS_WIN || defined Q_OS_MAC
+    //Windows blocked by a dialog still in the stack remain blocked.
+    auto is_blocked_by_stack = [](QWindow *w){
+        for (QGoodDialog *good_dialog : QGoodDialogUtils::m_dialog_stack)
+        {
+            if (good_dialog->m_window_list.contains(w))
+                return true;
+        }
+
+        return false;
+    };
+
+    //Skip the windows destroyed while the dialog was open.
+    const QWindowList window_list = qApp->allWindows();
+#endif
+
+#ifdef Q_OS_WIN
+    for (QWindow *w : m_window_list)
+    {
+        if (!window_list.contains(w) || is_blocked_by_stack(w))
+            continue;
 
-    m_dialog->setParent(nullptr);
-    m_child_gw->setParent(nullptr);
+        HWND hwnd = HWND(w->winId());
+        EnableWindow(hwnd, TRUE);
+    }
+
+    m_window_list.clear();
+#endif
+#ifdef Q_OS_MAC
+    for (QWindow *w : m_window_list)
+    {
+        if (!window_list.contains(w) || is_blocked_by_stack(w))
+            continue;
 
-    QGoodDialogUtils::m_dialog_is_visible = false;
+        w->setModality(Qt::NonModal);
+    }
 
-    return m_dialog->result();
+    m_window_list.clear();
+#endif
 }
 
 int QGoodDialog::exec(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow *parent_gw)
@@ -205,6 +309,20 @@ int QGoodDialog::exec(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow *paren
     return good_dialog.exec();
 }
 
+bool QGoodDialog::open(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow *parent_gw)
+{
+    QGoodDialog *good_dialog = new QGoodDialog(dialog, child_gw, parent_gw);
+    good_dialog->m_async = true;
+
+    if (!good_dialog->start())
+    {
+        delete good_dialog;
+        return false;
+    }
+
+    return true;
+}
+
 bool QGoodDialog::eventFilter(QObject *watched, QEvent *event)
 {
     if (watched == m_child_gw)
@@ -265,27 +383,31 @@ bool QGoodDialog::eventFilter(QObject *watched, QEvent *event)
 
             m_loop.quit();
 
-#ifdef Q_OS_WIN
-            for (QWindow *w : m_window_list)
-            {
-                HWND hwnd = HWND(w->winId());
-                EnableWindow(hwnd, TRUE);
-            }
+            QGoodDialogUtils::m_dialog_stack.removeAll(this);
 
-            m_window_list.clear();
-#endif
-#ifdef Q_OS_MAC
-            for (QWindow *w : m_window_list)
-            {
-                w->setModality(Qt::NonModal);
-            }
+            unblockWindows();
 
-            m_window_list.clear();
+#ifdef Q_OS_MAC
+            QPointer<QGoodWindow> parent_gw = m_parent_gw;
 
-            QTimer::singleShot(500, this, [=]{
-                m_parent_gw->setMacOSStyle(int(macOSNative::StyleType::NoState));
+            QTimer::singleShot(500, parent_gw, [=]{
+                if (parent_gw)
+                    parent_gw->setMacOSStyle(int(macOSNative::StyleType::NoState));
             });
 #endif
+
+            if (m_async)
+            {
+                //Take the dialog out of the window before a deferred delete of the window reaches it.
+                if (m_dialog)
+                {
+                    m_result = m_dialog->result();
+                    m_dialog->setParent(nullptr);
+                }
+
+                QTimer::singleShot(0, this, &QGoodDialog::finish);
+            }
+
             break;
         }
         case QEvent::UpdateRequest:
@@ -40,14 +40,21 @@ private:
 
 public:
     static int exec(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow *parent_gw);
+    static bool open(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow *parent_gw);
 
 private:
     //Functions
+    bool start();
+    void finish();
+    void unblockWindows();
     int exec();
     bool eventFilter(QObject *watched, QEvent *event);
 
     //Variables
     QEventLoop m_loop;
+    bool m_async;
+    bool m_finished;
+    int m_result;
     QPointer<QDialog> m_dialog;
     QPointer<QGoodWindow> m_child_gw;
     QPointer<QGoodWindow> m_parent_gw;
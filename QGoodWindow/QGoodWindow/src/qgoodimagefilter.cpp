@@ -0,0 +1,519 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "qgoodimagefilter.h"
+
+#if defined(__AVX2__)
+#define QGOODIMAGEFILTER_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define QGOODIMAGEFILTER_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define QGOODIMAGEFILTER_NEON
+#include <arm_neon.h>
+#endif
+
+namespace QGoodImageFilterUtils
+{
+//Kernels work on 32 bit pixels 0xAARRGGBB, each kernel handles the
+//vectorized body of a scan line and leaves the tail to the scalar code.
+//All backends use the same integer math, so the results are identical.
+
+//Gray = (11 * R + 16 * G + 5 * B) / 32, same as qGray.
+static inline quint32 grayPixel(quint32 pixel)
+{
+    const quint32 r = (pixel >> 16) & 0xFF;
+    const quint32 g = (pixel >> 8) & 0xFF;
+    const quint32 b = pixel & 0xFF;
+
+    const quint32 gray = (r * 11 + g * 16 + b * 5) >> 5;
+
+    return (pixel & 0xFF000000) | (gray * 0x010101);
+}
+
+//Fixed point product rounded as the SIMD kernels do, factor16 is the
+//factor multiplied by 65536.
+static inline quint32 dimChannel(quint32 channel, quint32 factor16)
+{
+    const quint32 t = ((channel << 8) * factor16) >> 16;
+
+    return (t + 128) >> 8;
+}
+
+//Premultiplied colors are inverted against the alpha so they stay valid.
+static inline quint32 invertPremultipliedPixel(quint32 pixel)
+{
+    const int a = int(pixel >> 24);
+    const int r = qMax(a - int((pixel >> 16) & 0xFF), 0);
+    const int g = qMax(a - int((pixel >> 8) & 0xFF), 0);
+    const int b = qMax(a - int(pixel & 0xFF), 0);
+
+    return (pixel & 0xFF000000) | (quint32(r) << 16) | (quint32(g) << 8) | quint32(b);
+}
+
+#if defined(QGOODIMAGEFILTER_AVX2)
+static const char *m_backend_name = "AVX2";
+
+static int grayscaleSimd(quint32 *pixels, int count)
+{
+    const __m256i mask_channel = _mm256_set1_epi32(0xFF);
+    const __m256i mask_alpha = _mm256_set1_epi32(int(0xFF000000));
+    const __m256i weight_r = _mm256_set1_epi32(11);
+    const __m256i weight_b = _mm256_set1_epi32(5);
+
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+
+        __m256i r = _mm256_and_si256(_mm256_srli_epi32(v, 16), mask_channel);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi32(v, 8), mask_channel);
+        __m256i b = _mm256_and_si256(v, mask_channel);
+
+        __m256i sum = _mm256_add_epi32(_mm256_mullo_epi16(r, weight_r), _mm256_slli_epi32(g, 4));
+        sum = _mm256_add_epi32(sum, _mm256_mullo_epi16(b, weight_b));
+
+        __m256i gray = _mm256_srli_epi32(sum, 5);
+        gray = _mm256_or_si256(gray, _mm256_or_si256(_mm256_slli_epi32(gray, 8), _mm256_slli_epi32(gray, 16)));
+
+        __m256i result = _mm256_or_si256(_mm256_and_si256(v, mask_alpha), gray);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), result);
+    }
+
+    return i;
+}
+
+static int dimSimd(quint32 *pixels, int count, quint32 factor16)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i factor = _mm256_set1_epi16(short(factor16));
+    const __m256i rounding = _mm256_set1_epi16(128);
+    const __m256i mask_alpha = _mm256_set1_epi32(int(0xFF000000));
+
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+
+        //Unpacking with zero on the low byte gives each channel shifted by 8.
+        __m256i lo = _mm256_mulhi_epu16(_mm256_unpacklo_epi8(zero, v), factor);
+        __m256i hi = _mm256_mulhi_epu16(_mm256_unpackhi_epi8(zero, v), factor);
+
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, rounding), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, rounding), 8);
+
+        __m256i dimmed = _mm256_packus_epi16(lo, hi);
+
+        __m256i result = _mm256_or_si256(_mm256_and_si256(v, mask_alpha),
+                                         _mm256_andnot_si256(mask_alpha, dimmed));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), result);
+    }
+
+    return i;
+}
+
+static int invertSimd(quint32 *pixels, int count)
+{
+    const __m256i mask_color = _mm256_set1_epi32(0x00FFFFFF);
+
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), _mm256_xor_si256(v, mask_color));
+    }
+
+    return i;
+}
+
+static int invertPremultipliedSimd(quint32 *pixels, int count)
+{
+    const __m256i mask_alpha = _mm256_set1_epi32(int(0xFF000000));
+
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+
+        __m256i a = _mm256_srli_epi32(v, 24);
+        a = _mm256_or_si256(a, _mm256_or_si256(_mm256_slli_epi32(a, 8), _mm256_slli_epi32(a, 16)));
+
+        __m256i inverted = _mm256_subs_epu8(a, _mm256_andnot_si256(mask_alpha, v));
+
+        __m256i result = _mm256_or_si256(_mm256_and_si256(v, mask_alpha), inverted);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), result);
+    }
+
+    return i;
+}
+#elif defined(QGOODIMAGEFILTER_SSE2)
+static const char *m_backend_name = "SSE2";
+
+static int grayscaleSimd(quint32 *pixels, int count)
+{
+    const __m128i mask_channel = _mm_set1_epi32(0xFF);
+    const __m128i mask_alpha = _mm_set1_epi32(int(0xFF000000));
+    const __m128i weight_r = _mm_set1_epi32(11);
+    const __m128i weight_b = _mm_set1_epi32(5);
+
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+
+        __m128i r = _mm_and_si128(_mm_srli_epi32(v, 16), mask_channel);
+        __m128i g = _mm_and_si128(_mm_srli_epi32(v, 8), mask_channel);
+        __m128i b = _mm_and_si128(v, mask_channel);
+
+        //Products fit in 16 bits, so the 16 bit multiply is enough.
+        __m128i sum = _mm_add_epi32(_mm_mullo_epi16(r, weight_r), _mm_slli_epi32(g, 4));
+        sum = _mm_add_epi32(sum, _mm_mullo_epi16(b, weight_b));
+
+        __m128i gray = _mm_srli_epi32(sum, 5);
+        gray = _mm_or_si128(gray, _mm_or_si128(_mm_slli_epi32(gray, 8), _mm_slli_epi32(gray, 16)));
+
+        __m128i result = _mm_or_si128(_mm_and_si128(v, mask_alpha), gray);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), result);
+    }
+
+    return i;
+}
+
+static int dimSimd(quint32 *pixels, int count, quint32 factor16)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i factor = _mm_set1_epi16(short(factor16));
+    const __m128i rounding = _mm_set1_epi16(128);
+    const __m128i mask_alpha = _mm_set1_epi32(int(0xFF000000));
+
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+
+        //Unpacking with zero on the low byte gives each channel shifted by 8.
+        __m128i lo = _mm_mulhi_epu16(_mm_unpacklo_epi8(zero, v), factor);
+        __m128i hi = _mm_mulhi_epu16(_mm_unpackhi_epi8(zero, v), factor);
+
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, rounding), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, rounding), 8);
+
+        __m128i dimmed = _mm_packus_epi16(lo, hi);
+
+        __m128i result = _mm_or_si128(_mm_and_si128(v, mask_alpha),
+                                      _mm_andnot_si128(mask_alpha, dimmed));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), result);
+    }
+
+    return i;
+}
+
+static int invertSimd(quint32 *pixels, int count)
+{
+    const __m128i mask_color = _mm_set1_epi32(0x00FFFFFF);
+
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), _mm_xor_si128(v, mask_color));
+    }
+
+    return i;
+}
+
+static int invertPremultipliedSimd(quint32 *pixels, int count)
+{
+    const __m128i mask_alpha = _mm_set1_epi32(int(0xFF000000));
+
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+
+        __m128i a = _mm_srli_epi32(v, 24);
+        a = _mm_or_si128(a, _mm_or_si128(_mm_slli_epi32(a, 8), _mm_slli_epi32(a, 16)));
+
+        __m128i inverted = _mm_subs_epu8(a, _mm_andnot_si128(mask_alpha, v));
+
+        __m128i result = _mm_or_si128(_mm_and_si128(v, mask_alpha), inverted);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), result);
+    }
+
+    return i;
+}
+#elif defined(QGOODIMAGEFILTER_NEON)
+static const char *m_backend_name = "NEON";
+
+static int grayscaleSimd(quint32 *pixels, int count)
+{
+    const uint32x4_t mask_channel = vdupq_n_u32(0xFF);
+    const uint32x4_t mask_alpha = vdupq_n_u32(0xFF000000);
+
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32x4_t v = vld1q_u32(pixels + i);
+
+        uint32x4_t r = vandq_u32(vshrq_n_u32(v, 16), mask_channel);
+        uint32x4_t g = vandq_u32(vshrq_n_u32(v, 8), mask_channel);
+        uint32x4_t b = vandq_u32(v, mask_channel);
+
+        uint32x4_t sum = vmulq_n_u32(r, 11);
+        sum = vaddq_u32(sum, vshlq_n_u32(g, 4));
+        sum = vmlaq_n_u32(sum, b, 5);
+
+        uint32x4_t gray = vshrq_n_u32(sum, 5);
+        gray = vorrq_u32(gray, vorrq_u32(vshlq_n_u32(gray, 8), vshlq_n_u32(gray, 16)));
+
+        vst1q_u32(pixels + i, vorrq_u32(vandq_u32(v, mask_alpha), gray));
+    }
+
+    return i;
+}
+
+static int dimSimd(quint32 *pixels, int count, quint32 factor16)
+{
+    const uint16x4_t factor = vdup_n_u16(quint16(factor16));
+    const uint32x4_t mask_alpha = vdupq_n_u32(0xFF000000);
+
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32x4_t v = vld1q_u32(pixels + i);
+        uint8x16_t bytes = vreinterpretq_u8_u32(v);
+
+        uint16x8_t lo = vshlq_n_u16(vmovl_u8(vget_low_u8(bytes)), 8);
+        uint16x8_t hi = vshlq_n_u16(vmovl_u8(vget_high_u8(bytes)), 8);
+
+        //High half of the 16 bit products, then rounded by 8 bits.
+        uint16x8_t lo_t = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(lo), factor), 16),
+                                       vshrn_n_u32(vmull_u16(vget_high_u16(lo), factor), 16));
+        uint16x8_t hi_t = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(hi), factor), 16),
+                                       vshrn_n_u32(vmull_u16(vget_high_u16(hi), factor), 16));
+
+        uint8x16_t dimmed = vcombine_u8(vqmovn_u16(vrshrq_n_u16(lo_t, 8)),
+                                        vqmovn_u16(vrshrq_n_u16(hi_t, 8)));
+
+        uint32x4_t result = vbslq_u32(mask_alpha, v, vreinterpretq_u32_u8(dimmed));
+
+        vst1q_u32(pixels + i, result);
+    }
+
+    return i;
+}
+
+static int invertSimd(quint32 *pixels, int count)
+{
+    const uint32x4_t mask_color = vdupq_n_u32(0x00FFFFFF);
+
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32x4_t v = vld1q_u32(pixels + i);
+
+        vst1q_u32(pixels + i, veorq_u32(v, mask_color));
+    }
+
+    return i;
+}
+
+static int invertPremultipliedSimd(quint32 *pixels, int count)
+{
+    const uint32x4_t mask_alpha = vdupq_n_u32(0xFF000000);
+
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32x4_t v = vld1q_u32(pixels + i);
+
+        uint32x4_t a = vshrq_n_u32(v, 24);
+        a = vorrq_u32(a, vorrq_u32(vshlq_n_u32(a, 8), vshlq_n_u32(a, 16)));
+
+        uint8x16_t inverted = vqsubq_u8(vreinterpretq_u8_u32(a),
+                                        vreinterpretq_u8_u32(vbicq_u32(v, mask_alpha)));
+
+        vst1q_u32(pixels + i, vbslq_u32(mask_alpha, v, vreinterpretq_u32_u8(inverted)));
+    }
+
+    return i;
+}
+#else
+static const char *m_backend_name = "Scalar";
+
+static int grayscaleSimd(quint32 *pixels, int count)
+{
+    Q_UNUSED(pixels)
+    Q_UNUSED(count)
+    return 0;
+}
+
+static int dimSimd(quint32 *pixels, int count, quint32 factor16)
+{
+    Q_UNUSED(pixels)
+    Q_UNUSED(count)
+    Q_UNUSED(factor16)
+    return 0;
+}
+
+static int invertSimd(quint32 *pixels, int count)
+{
+    Q_UNUSED(pixels)
+    Q_UNUSED(count)
+    return 0;
+}
+
+static int invertPremultipliedSimd(quint32 *pixels, int count)
+{
+    Q_UNUSED(pixels)
+    Q_UNUSED(count)
+    return 0;
+}
+#endif
+
+static void grayscaleLine(quint32 *pixels, int count)
+{
+    for (int i = grayscaleSimd(pixels, count); i < count; i++)
+        pixels[i] = grayPixel(pixels[i]);
+}
+
+static void dimLine(quint32 *pixels, int count, quint32 factor16, const quint8 *lut)
+{
+    for (int i = dimSimd(pixels, count, factor16); i < count; i++)
+    {
+        const quint32 pixel = pixels[i];
+
+        pixels[i] = (pixel & 0xFF000000) |
+                (quint32(lut[(pixel >> 16) & 0xFF]) << 16) |
+                (quint32(lut[(pixel >> 8) & 0xFF]) << 8) |
+                quint32(lut[pixel & 0xFF]);
+    }
+}
+
+static void invertLine(quint32 *pixels, int count)
+{
+    for (int i = invertSimd(pixels, count); i < count; i++)
+        pixels[i] ^= 0x00FFFFFF;
+}
+
+static void invertPremultipliedLine(quint32 *pixels, int count)
+{
+    for (int i = invertPremultipliedSimd(pixels, count); i < count; i++)
+        pixels[i] = invertPremultipliedPixel(pixels[i]);
+}
+}
+
+QImage QGoodImageFilter::toFilterFormat(const QImage &image)
+{
+    switch (image.format())
+    {
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32:
+    case QImage::Format_ARGB32_Premultiplied:
+        return image;
+    default:
+        return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+}
+
+QImage QGoodImageFilter::grayscaled(const QImage &image)
+{
+    QImage result = toFilterFormat(image);
+
+    for (int y = 0; y < result.height(); y++)
+    {
+        quint32 *line = reinterpret_cast<quint32*>(result.scanLine(y));
+        QGoodImageFilterUtils::grayscaleLine(line, result.width());
+    }
+
+    return result;
+}
+
+QImage QGoodImageFilter::dimmed(const QImage &image, qreal factor)
+{
+    QImage result = toFilterFormat(image);
+
+    if (factor >= qreal(1))
+        return result;
+
+    const quint32 factor16 = quint32(qBound(0, qRound(factor * 65536), 65535));
+
+    quint8 lut[256];
+
+    for (int i = 0; i < 256; i++)
+        lut[i] = quint8(QGoodImageFilterUtils::dimChannel(quint32(i), factor16));
+
+    for (int y = 0; y < result.height(); y++)
+    {
+        quint32 *line = reinterpret_cast<quint32*>(result.scanLine(y));
+        QGoodImageFilterUtils::dimLine(line, result.width(), factor16, lut);
+    }
+
+    return result;
+}
+
+QImage QGoodImageFilter::inverted(const QImage &image)
+{
+    QImage result = toFilterFormat(image);
+
+    const bool premultiplied = (result.format() == QImage::Format_ARGB32_Premultiplied);
+
+    for (int y = 0; y < result.height(); y++)
+    {
+        quint32 *line = reinterpret_cast<quint32*>(result.scanLine(y));
+
+        if (premultiplied)
+            QGoodImageFilterUtils::invertPremultipliedLine(line, result.width());
+        else
+            QGoodImageFilterUtils::invertLine(line, result.width());
+    }
+
+    return result;
+}
+
+const char *QGoodImageFilter::backendName()
+{
+    return QGoodImageFilterUtils::m_backend_name;
+}
@@ -0,0 +1,53 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef QGOODIMAGEFILTER_H
+#define QGOODIMAGEFILTER_H
+
+#include <QtCore>
+#include <QtGui>
+
+//\cond HIDDEN_SYMBOLS
+class QGoodImageFilter
+{
+public:
+    //Converts the colors to gray using the qGray weights, keeping the alpha.
+    static QImage grayscaled(const QImage &image);
+
+    //Multiplies the colors by factor, keeping the alpha.
+    static QImage dimmed(const QImage &image, qreal factor);
+
+    //Inverts the colors, keeping the alpha.
+    static QImage inverted(const QImage &image);
+
+    //Name of the kernels selected at compile time.
+    static const char *backendName();
+
+private:
+    //Functions
+    static QImage toFilterFormat(const QImage &image);
+};
+//\endcond
+
+#endif // QGOODIMAGEFILTER_H
@@ -0,0 +1,156 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "qgoodscheduler.h"
+#include "qgoodwindowstats.h"
+
+//Granularity of the deadlines of delayed tasks in milliseconds.
+#define SCHEDULER_GRANULARITY 25
+
+QGoodScheduler::QGoodScheduler() : QObject()
+{
+    m_clock.start();
+
+    m_timer_deadline = -1;
+    m_sequence = 0;
+
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::CoarseTimer);
+    connect(m_timer, &QTimer::timeout, this, &QGoodScheduler::run);
+}
+
+QGoodScheduler *QGoodScheduler::instance()
+{
+    static QThreadStorage<QGoodScheduler*> storage;
+
+    if (!storage.hasLocalData())
+        storage.setLocalData(new QGoodScheduler());
+
+    return storage.localData();
+}
+
+void QGoodScheduler::schedule(QObject *owner, Task task, int msecs, const std::function<void()> &function)
+{
+    QGoodScheduler *scheduler = instance();
+
+    qint64 deadline = scheduler->m_clock.elapsed();
+
+    if (msecs > 0)
+    {
+        deadline += msecs;
+        deadline = ((deadline + SCHEDULER_GRANULARITY - 1) / SCHEDULER_GRANULARITY) * SCHEDULER_GRANULARITY;
+    }
+
+    Entry entry;
+    entry.owner = owner;
+    entry.deadline = deadline;
+    entry.sequence = scheduler->m_sequence++;
+    entry.function = function;
+
+    scheduler->m_entry_hash.insert(Key(owner, int(task)), entry);
+
+    scheduler->wakeUpAt(deadline);
+}
+
+void QGoodScheduler::cancel(QObject *owner, Task task)
+{
+    QGoodScheduler *scheduler = instance();
+
+    scheduler->m_entry_hash.remove(Key(owner, int(task)));
+
+    //The timer is left running, a wakeup without due tasks only reschedules.
+}
+
+bool QGoodScheduler::isScheduled(QObject *owner, Task task)
+{
+    QGoodScheduler *scheduler = instance();
+
+    auto it = scheduler->m_entry_hash.constFind(Key(owner, int(task)));
+
+    //A task left by a destroyed owner doesn't count for a new object at the same address.
+    return (it != scheduler->m_entry_hash.constEnd() && !it.value().owner.isNull());
+}
+
+void QGoodScheduler::wakeUpAt(qint64 deadline)
+{
+    //Keep the running timer if it already wakes up in time, a task moved
+    //to a later deadline is rescheduled when the timer fires.
+    if (m_timer->isActive() && m_timer_deadline <= deadline)
+        return;
+
+    m_timer_deadline = deadline;
+    m_timer->start(int(qMax(deadline - m_clock.elapsed(), qint64(0))));
+}
+
+void QGoodScheduler::run()
+{
+    QGoodWindowStats::Scope stats_scope(nullptr, QGoodWindowStats::Counter::TimerWakeup);
+
+    m_timer_deadline = -1;
+
+    const qint64 now = m_clock.elapsed();
+
+    qint64 next_deadline = -1;
+
+    //The due tasks stay in the hash until they run,
+    //so a task can still cancel the ones after it.
+    QList<QPair<quint64, Key>> due_list;
+
+    for (auto it = m_entry_hash.cbegin(); it != m_entry_hash.cend(); ++it)
+    {
+        if (it.value().deadline <= now)
+        {
+            due_list.append(qMakePair(it.value().sequence, it.key()));
+        }
+        else
+        {
+            if (next_deadline < 0 || it.value().deadline < next_deadline)
+                next_deadline = it.value().deadline;
+        }
+    }
+
+    if (next_deadline >= 0)
+        wakeUpAt(next_deadline);
+
+    //Run in the order the tasks were scheduled.
+    std::sort(due_list.begin(), due_list.end(), [](const QPair<quint64, Key> &due1, const QPair<quint64, Key> &due2){
+        return due1.first < due2.first;
+    });
+
+    for (const QPair<quint64, Key> &due : due_list)
+    {
+        auto it = m_entry_hash.find(due.second);
+
+        //Cancelled, or scheduled again with it's own deadline, by a task run before.
+        if (it == m_entry_hash.end() || it.value().sequence != due.first)
+            continue;
+
+        const Entry entry = it.value();
+        m_entry_hash.erase(it);
+
+        if (entry.owner)
+            entry.function();
+    }
+}
@@ -0,0 +1,88 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef QGOODSCHEDULER_H
+#define QGOODSCHEDULER_H
+
+#include <QtCore>
+
+//\cond HIDDEN_SYMBOLS
+//Runs the deferred work of the window chrome from a single coarse timer per thread,
+//instead of a timer per window and task. A task is identified by it's owner and kind,
+//scheduling it again replaces the pending one, and tasks of destroyed owners don't run.
+class QGoodScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Task
+    {
+        ThemeChange,
+        WindowSetup,
+        WindowTitleChanged,
+        WindowIconChanged,
+        CompositionChange,
+        ShadowShow,
+        ReleaseResources,
+        UpdatePass,
+        CentralWidgetCorners,
+        TitleBarBackground,
+        DialogPoolFill
+    };
+
+    //Runs function after msecs, deadlines are rounded up to the timer granularity
+    //so tasks due at about the same time share a wakeup.
+    static void schedule(QObject *owner, Task task, int msecs, const std::function<void()> &function);
+    static void cancel(QObject *owner, Task task);
+    static bool isScheduled(QObject *owner, Task task);
+
+private:
+    explicit QGoodScheduler();
+
+    struct Entry
+    {
+        QPointer<QObject> owner;
+        qint64 deadline;
+        quint64 sequence;
+        std::function<void()> function;
+    };
+
+    typedef QPair<QObject*, int> Key;
+
+    //Functions
+    static QGoodScheduler *instance();
+    void wakeUpAt(qint64 deadline);
+    void run();
+
+    //Variables
+    QHash<Key, Entry> m_entry_hash;
+    QTimer *m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_timer_deadline;
+    quint64 m_sequence;
+
+    Q_DISABLE_COPY(QGoodScheduler)
+};
+//\endcond
+
+#endif // QGOODSCHEDULER_H
@@ -0,0 +1,180 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "qgoodtrace.h"
+
+#ifdef QGOODWINDOW_TRACE
+
+namespace QGoodTraceUtils
+{
+struct TraceEvent
+{
+    const char *name;
+    qint64 start;
+    qint64 duration;
+    quintptr thread;
+};
+
+//Flush the buffered events to the file after this count.
+static const int m_flush_count = 4096;
+
+class TraceWriter
+{
+public:
+    TraceWriter()
+    {
+        const QString file_name = qEnvironmentVariable("QGOODWINDOW_TRACE_FILE");
+
+        m_enabled = false;
+        m_first_event = true;
+
+        if (file_name.isEmpty())
+            return;
+
+        m_file.setFileName(file_name);
+
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+            return;
+
+        m_file.write("{\"traceEvents\":[\n");
+
+        m_events.reserve(m_flush_count);
+
+        m_timer.start();
+
+        m_enabled = true;
+    }
+
+    ~TraceWriter()
+    {
+        if (!m_enabled)
+            return;
+
+        QMutexLocker locker(&m_mutex);
+
+        flush();
+
+        m_file.write("\n],\"displayTimeUnit\":\"ms\"}\n");
+        m_file.close();
+    }
+
+    bool isEnabled() const
+    {
+        return m_enabled;
+    }
+
+    qint64 timestamp() const
+    {
+        return m_timer.nsecsElapsed() / 1000;
+    }
+
+    void record(const char *name, qint64 start, qint64 duration)
+    {
+        TraceEvent event;
+        event.name = name;
+        event.start = start;
+        event.duration = duration;
+        event.thread = quintptr(QThread::currentThreadId());
+
+        QMutexLocker locker(&m_mutex);
+
+        m_events.append(event);
+
+        if (m_events.size() >= m_flush_count)
+            flush();
+    }
+
+private:
+    void flush()
+    {
+        const qint64 pid = QCoreApplication::applicationPid();
+
+        QByteArray data;
+
+        for (const TraceEvent &event : m_events)
+        {
+            if (!m_first_event)
+                data += ",\n";
+
+            m_first_event = false;
+
+            //Names are string literals of the trace points, no escaping is needed.
+            data += "{\"name\":\"";
+            data += event.name;
+            data += "\",\"cat\":\"QGoodWindow\",\"ph\":\"X\",\"ts\":";
+            data += QByteArray::number(event.start);
+            data += ",\"dur\":";
+            data += QByteArray::number(event.duration);
+            data += ",\"pid\":";
+            data += QByteArray::number(pid);
+            data += ",\"tid\":";
+            data += QByteArray::number(quint64(event.thread));
+            data += "}";
+        }
+
+        m_events.clear();
+
+        m_file.write(data);
+        m_file.flush();
+    }
+
+    bool m_enabled;
+    bool m_first_event;
+    QFile m_file;
+    QElapsedTimer m_timer;
+    QMutex m_mutex;
+    QVector<TraceEvent> m_events;
+};
+
+static TraceWriter &writer()
+{
+    static TraceWriter trace_writer;
+    return trace_writer;
+}
+}
+
+void QGoodTrace::instant(const char *name)
+{
+    if (!isEnabled())
+        return;
+
+    record(name, timestamp(), 0);
+}
+
+bool QGoodTrace::isEnabled()
+{
+    return QGoodTraceUtils::writer().isEnabled();
+}
+
+qint64 QGoodTrace::timestamp()
+{
+    return QGoodTraceUtils::writer().timestamp();
+}
+
+void QGoodTrace::record(const char *name, qint64 start, qint64 duration)
+{
+    QGoodTraceUtils::writer().record(name, start, duration);
+}
+
+#endif
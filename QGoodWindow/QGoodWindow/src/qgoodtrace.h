@@ -0,0 +1,78 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef QGOODTRACE_H
+#define QGOODTRACE_H
+
+#include <QtCore>
+
+#include "qgoodwindow_global.h"
+
+//\cond HIDDEN_SYMBOLS
+#ifdef QGOODWINDOW_TRACE
+//Scoped trace point, records the time spent between construction and destruction.
+//Events are written in the Chrome trace format to the file named by the
+//QGOODWINDOW_TRACE_FILE environment variable, nothing is recorded if it's unset.
+class QGOODWINDOW_SHARED_EXPORT QGoodTrace
+{
+public:
+    explicit QGoodTrace(const char *name)
+    {
+        m_name = name;
+        m_start = isEnabled() ? timestamp() : -1;
+    }
+
+    ~QGoodTrace()
+    {
+        if (m_start >= 0)
+            record(m_name, m_start, timestamp() - m_start);
+    }
+
+    //Records a zero duration event.
+    static void instant(const char *name);
+
+    static bool isEnabled();
+
+private:
+    //Functions
+    static qint64 timestamp();
+    static void record(const char *name, qint64 start, qint64 duration);
+
+    //Variables
+    const char *m_name;
+    qint64 m_start;
+
+    Q_DISABLE_COPY(QGoodTrace)
+};
+
+#define QGOODWINDOW_TRACE_SCOPE(name) QGoodTrace qgoodwindow_trace_scope(name)
+#define QGOODWINDOW_TRACE_INSTANT(name) QGoodTrace::instant(name)
+#else
+//Trace points compile to nothing unless QGOODWINDOW_TRACE is defined.
+#define QGOODWINDOW_TRACE_SCOPE(name) do {} while (false)
+#define QGOODWINDOW_TRACE_INSTANT(name) do {} while (false)
+#endif
+//\endcond
+
+#endif // QGOODTRACE_H
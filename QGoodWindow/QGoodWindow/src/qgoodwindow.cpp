@@ -28,6 +28,7 @@ SOFTWARE.
 
 #include "common.h"
 #include "qgoodwindow.h"
+#include "qgoodscheduler.h"
 #include "shadow.h"
 #include "qgooddialog.h"
 #include "../version/version.h"
@@ -54,6 +55,96 @@ SOFTWARE.
 #include <QGoodCentralWidget>
 #endif
 
+#ifdef QGOODWINDOW
+namespace QGoodWindowUtils
+{
+//All the QGoodWindow instances of the process, a set keeps
+//registration and removal constant time with thousands of windows.
+static QSet<QGoodWindow*> m_gw_set;
+
+//The system theme as known by the process. It's queried once and then kept
+//current by the theme change notifications, so new windows don't query it.
+static bool m_system_theme_dark = false;
+static bool m_system_theme_known = false;
+
+static bool systemThemeDark()
+{
+    if (!m_system_theme_known)
+    {
+        m_system_theme_dark = QGoodWindow::isSystemThemeDark();
+        m_system_theme_known = true;
+    }
+
+    return m_system_theme_dark;
+}
+
+static void dispatchThemeChange()
+{
+    QGOODWINDOW_TRACE_SCOPE("QGoodWindow::dispatchThemeChange");
+
+    //Query the system theme once for all windows.
+    m_system_theme_known = false;
+    const bool dark = systemThemeDark();
+
+    //A window may be destroyed by a systemThemeChanged() handler.
+    QList<QPointer<QGoodWindow>> gw_list;
+    gw_list.reserve(m_gw_set.size());
+
+    for (QGoodWindow *gw : m_gw_set)
+        gw_list.append(gw);
+
+    for (const QPointer<QGoodWindow> &gw : gw_list)
+    {
+        if (gw)
+            gw->themeChanged(dark);
+    }
+}
+
+static void themeChangeLater()
+{
+    //One queued call serves every window no matter how many
+    //notifications the system sends in the same iteration.
+    QGoodScheduler::schedule(qApp, QGoodScheduler::Task::ThemeChange, 0, &dispatchThemeChange);
+}
+
+//The icon of windows created without one. It's loaded once and shared by all
+//windows, so the title bar renders it once, and loaded again only when the
+//style or the icon theme changes.
+static QIcon m_default_icon;
+static QPointer<QStyle> m_default_icon_style;
+static QString m_default_icon_theme;
+
+static void releaseDefaultWindowIcon()
+{
+    //The icon may hold pixmaps, which must not outlive the application.
+    m_default_icon = QIcon();
+}
+
+static QIcon defaultWindowIcon()
+{
+    QStyle *style = qApp->style();
+    const QString icon_theme = QIcon::themeName();
+
+    if (m_default_icon.isNull() || m_default_icon_style != style || m_default_icon_theme != icon_theme)
+    {
+        static bool post_routine_added = false;
+
+        if (!post_routine_added)
+        {
+            qAddPostRoutine(&releaseDefaultWindowIcon);
+            post_routine_added = true;
+        }
+
+        m_default_icon = style->standardIcon(QStyle::SP_DesktopIcon);
+        m_default_icon_style = style;
+        m_default_icon_theme = icon_theme;
+    }
+
+    return m_default_icon;
+}
+}
+#endif
+
 #ifdef Q_OS_WIN
 
 #ifdef QT_VERSION_QT5
@@ -96,13 +187,38 @@ private:
     }
 };
 
+//A single filter is installed for all windows of the process, the window
+//is found by the top level ancestor of the message target, so the cost
+//of each native message doesn't grow with the number of windows.
 class NativeEventFilter : public QAbstractNativeEventFilter
 {
 public:
-    NativeEventFilter(QGoodWindow *gw)
+    static NativeEventFilter *addWindow(QGoodWindow *gw, HWND gw_hwnd)
+    {
+        if (!m_instance)
+        {
+            m_instance = new NativeEventFilter();
+            qApp->installNativeEventFilter(m_instance);
+        }
+
+        m_instance->m_gw_hash.insert(gw_hwnd, gw);
+
+        return m_instance;
+    }
+
+    static void removeWindow(HWND gw_hwnd)
     {
-        m_gw = gw;
-        m_gw_hwnd = HWND(m_gw->winId());
+        if (!m_instance)
+            return;
+
+        m_instance->m_gw_hash.remove(gw_hwnd);
+
+        if (m_instance->m_gw_hash.isEmpty())
+        {
+            qApp->removeNativeEventFilter(m_instance);
+            delete m_instance;
+            m_instance = nullptr;
+        }
     }
 
     bool nativeEventFilter(const QByteArray &eventType, void *message, qgoodintptr *result) override
@@ -114,7 +230,15 @@ public:
         if (!IsWindowVisible(msg->hwnd))
             return false;
 
-        if (!IsChild(m_gw_hwnd, msg->hwnd))
+        HWND gw_hwnd = GetAncestor(msg->hwnd, GA_ROOT);
+
+        //Only messages of the child windows are handled.
+        if (!gw_hwnd || gw_hwnd == msg->hwnd)
+            return false;
+
+        QGoodWindow *gw = m_gw_hash.value(gw_hwnd);
+
+        if (!gw)
             return false;
 
         switch (msg->message)
@@ -123,7 +247,7 @@ public:
         {
             QPoint pos = QPoint(GET_X_LPARAM(msg->lParam), GET_Y_LPARAM(msg->lParam));
 
-            HRESULT lresult = HRESULT(m_gw->ncHitTest(pos.x(), pos.y()));
+            HRESULT lresult = HRESULT(gw->ncHitTest(pos.x(), pos.y()));
 
             if (lresult == HTNOWHERE)
                 break;
@@ -157,14 +281,14 @@ public:
             if ((GetKeyState(VK_SHIFT) & 0x8000) && msg->wParam == VK_F10)
             {
                 // ...when SHIFT+F10 is pressed.
-                SendMessageW(m_gw_hwnd, msg->message, msg->wParam, msg->lParam);
+                SendMessageW(gw_hwnd, msg->message, msg->wParam, msg->lParam);
                 return true;
             }
 
             if ((GetKeyState(VK_MENU) & 0x8000) && msg->wParam == VK_SPACE)
             {
                 // ...when ALT+SPACE is pressed.
-                SendMessageW(m_gw_hwnd, msg->message, msg->wParam, msg->lParam);
+                SendMessageW(gw_hwnd, msg->message, msg->wParam, msg->lParam);
                 return true;
             }
 
@@ -178,30 +302,36 @@ public:
     }
 
 private:
-    QPointer<QGoodWindow> m_gw;
-    HWND m_gw_hwnd;
+    static NativeEventFilter *m_instance;
+
+    QHash<HWND, QGoodWindow*> m_gw_hash;
 };
 
+NativeEventFilter *NativeEventFilter::m_instance = nullptr;
+
 inline bool isWinXOrGreater(DWORD major_version, DWORD minor_version, DWORD build_number)
 {
-    bool is_win_x_or_greater = false;
+    //The version is resolved once per process instead of once per window.
+    static const OSVERSIONINFOEXW os_info = []{
+        OSVERSIONINFOEXW info;
+        memset(&info, 0, sizeof(OSVERSIONINFOEXW));
 
-    typedef NTSTATUS(WINAPI *tRtlGetVersion)(LPOSVERSIONINFOEXW);
-    tRtlGetVersion pRtlGetVersion = tRtlGetVersion(QLibrary::resolve("ntdll", "RtlGetVersion"));
+        typedef NTSTATUS(WINAPI *tRtlGetVersion)(LPOSVERSIONINFOEXW);
+        tRtlGetVersion pRtlGetVersion = tRtlGetVersion(QLibrary::resolve("ntdll", "RtlGetVersion"));
 
-    if (pRtlGetVersion)
-    {
-        OSVERSIONINFOEXW os_info;
-        memset(&os_info, 0, sizeof(OSVERSIONINFOEXW));
-        os_info.dwOSVersionInfoSize = sizeof(OSVERSIONINFOEXW);
-        NTSTATUS status = pRtlGetVersion(&os_info);
-        if (status == 0)
+        if (pRtlGetVersion)
         {
-            is_win_x_or_greater = (os_info.dwMajorVersion >= major_version &&
-                                   os_info.dwMinorVersion >= minor_version &&
-                                   os_info.dwBuildNumber >= build_number);
+            info.dwOSVersionInfoSize = sizeof(OSVERSIONINFOEXW);
+            if (pRtlGetVersion(&info) != 0)
+                memset(&info, 0, sizeof(OSVERSIONINFOEXW));
         }
-    }
+
+        return info;
+    }();
+
+    bool is_win_x_or_greater = (os_info.dwMajorVersion >= major_version &&
+                                os_info.dwMinorVersion >= minor_version &&
+                                os_info.dwBuildNumber >= build_number);
 
     return is_win_x_or_greater;
 }
@@ -230,16 +360,13 @@ inline bool isWin11OrGreater()
 
 namespace QGoodWindowUtils
 {
-QList<QGoodWindow*> m_gw_list;
-
 GtkSettings *m_settings = nullptr;
 
 void themeChangeNotification()
 {
-    for (QGoodWindow *gw : m_gw_list)
-    {
-        QTimer::singleShot(0, gw, &QGoodWindow::themeChanged);
-    }
+    QGOODWINDOW_TRACE_SCOPE("QGoodWindow::themeChangeNotification");
+
+    themeChangeLater();
 }
 
 void registerThemeChangeNotification()
@@ -248,6 +375,9 @@ void registerThemeChangeNotification()
     {
         m_settings = gtk_settings_get_default();
         g_signal_connect(m_settings, "notify::gtk-theme-name", themeChangeNotification, nullptr);
+
+        //Changes made before the registration were missed.
+        m_system_theme_known = false;
     }
 }
 }
@@ -280,7 +410,7 @@ QGoodWindow::QGoodWindow(QWidget *parent, const QColor &clear_color) : QMainWind
 
     m_is_using_system_borders = shouldBordersBeDrawnBySystem();
 
-    m_dark = isSystemThemeDark();
+    m_dark = QGoodWindowUtils::systemThemeDark();
 
     m_title_bar_height = 30;
     m_icon_width = 0;
@@ -289,11 +419,17 @@ QGoodWindow::QGoodWindow(QWidget *parent, const QColor &clear_color) : QMainWind
     m_last_caption_button_hovered = -1;
     m_caption_button_pressed = -1;
 
-    m_hover_timer = new QTimer(this);
-    m_hover_timer->setSingleShot(true);
-    m_hover_timer->setInterval(300);
+    m_hover_timer.invalidate();
+
+    m_auto_release_cached_resources = true;
+
+    m_default_icon_key = 0;
+
+    m_native_window_created = false;
 
     m_pixel_ratio = qreal(1);
+
+    QGoodWindowUtils::m_gw_set.insert(this);
 #endif
 #ifdef Q_OS_WIN
     m_clear_color = clear_color;
@@ -401,14 +537,6 @@ QGoodWindow::QGoodWindow(QWidget *parent, const QColor &clear_color) : QMainWind
     m_helper_window->setGeometry(0, 0, 1, 1);
     m_helper_window->setOpacity(0);
 #endif
-    if (!m_is_using_system_borders)
-    {
-        QGoodWindow *parent = m_parent ? this : nullptr;
-        m_shadow = new Shadow(qintptr(m_hwnd), parent, parent);
-        m_shadow->createWinId();
-        connect(m_shadow, &Shadow::showSignal, this, &QGoodWindow::moveShadow);
-    }
-
     m_main_window = static_cast<QMainWindow*>(this);
     m_main_window->createWinId();
     m_main_window->installEventFilter(this);
@@ -426,10 +554,7 @@ QGoodWindow::QGoodWindow(QWidget *parent, const QColor &clear_color) : QMainWind
         m_parent->installEventFilter(this);
 
     if (!m_native_event)
-    {
-        m_native_event = new QGoodWindowUtils::NativeEventFilter(this);
-        qApp->installNativeEventFilter(m_native_event);
-    }
+        m_native_event = QGoodWindowUtils::NativeEventFilter::addWindow(this, m_hwnd);
 
     if (m_parent)
     {
@@ -456,13 +581,9 @@ QGoodWindow::QGoodWindow(QWidget *parent, const QColor &clear_color) : QMainWind
     installEventFilter(this);
     setMouseTracking(true);
 
-    createWinId();
-
-    m_pixel_ratio = windowHandle()->screen()->devicePixelRatio();
-
-    QGoodWindowUtils::registerThemeChangeNotification();
-
-    QGoodWindowUtils::m_gw_list.append(this);
+    //The native window, the shadow and the theme change notification
+    //are created on the first show or winId() call, see createNativeWindow().
+    m_pixel_ratio = qApp->primaryScreen()->devicePixelRatio();
 
     //Fake window flags.
     m_window_flags = Qt::Window | Qt::FramelessWindowHint;
@@ -476,18 +597,11 @@ QGoodWindow::QGoodWindow(QWidget *parent, const QColor &clear_color) : QMainWind
     {
         QMainWindow::setWindowFlags(Qt::Window | Qt::FramelessWindowHint | Qt::Tool);
     }
-
-    m_shadow = new Shadow(qintptr(nullptr), this, this);
-    m_shadow->installEventFilter(this);
-    m_shadow->setMouseTracking(true);
-    connect(m_shadow, &Shadow::showSignal, this, &QGoodWindow::sizeMoveBorders);
 #endif
 #ifdef Q_OS_MAC
     installEventFilter(this);
     setMouseTracking(true);
 
-    createWinId();
-
     style_ptr = new macOSNative::Style();
 
     macOSNative::Style *style = static_cast<macOSNative::Style*>(style_ptr);
@@ -495,12 +609,6 @@ QGoodWindow::QGoodWindow(QWidget *parent, const QColor &clear_color) : QMainWind
 
     notification.addWindow(this);
 
-    if (!QGoodWindowUtils::m_theme_change_registered)
-    {
-        QGoodWindowUtils::m_theme_change_registered = true;
-        macOSNative::registerThemeChangeNotification();
-    }
-
     if (!m_parent)
         QMainWindow::setWindowFlags(Qt::Window);
     else
@@ -511,17 +619,24 @@ QGoodWindow::QGoodWindow(QWidget *parent, const QColor &clear_color) : QMainWind
         if (windowTitle().isEmpty())
         {
             setWindowTitle(qApp->applicationName());
-            QTimer::singleShot(0, this, [=]{Q_EMIT windowTitleChanged(windowTitle());});
+            QGoodScheduler::schedule(this, QGoodScheduler::Task::WindowTitleChanged, 0, [=]{
+                Q_EMIT windowTitleChanged(windowTitle());
+            });
         }
 
         if (windowIcon().isNull())
         {
-            setWindowIcon(qApp->style()->standardIcon(QStyle::SP_DesktopIcon));
-            QTimer::singleShot(0, this, [=]{Q_EMIT windowIconChanged(windowIcon());});
+            const QIcon icon = QGoodWindowUtils::defaultWindowIcon();
+            m_default_icon_key = icon.cacheKey();
+
+            setWindowIcon(icon);
+            QGoodScheduler::schedule(this, QGoodScheduler::Task::WindowIconChanged, 0, [=]{
+                Q_EMIT windowIconChanged(windowIcon());
+            });
         }
     };
 #ifdef Q_OS_WIN
-    QTimer::singleShot(0, this, func_default_name_icon);
+    QGoodScheduler::schedule(this, QGoodScheduler::Task::WindowSetup, 0, func_default_name_icon);
 #else
     func_default_name_icon();
 #endif
@@ -539,13 +654,17 @@ QGoodWindow::~QGoodWindow()
 
     if (m_native_event)
     {
-        qApp->removeNativeEventFilter(m_native_event);
-        delete m_native_event;
+        QGoodWindowUtils::NativeEventFilter::removeWindow(m_hwnd);
         m_native_event = nullptr;
     }
 #endif
-#ifdef Q_OS_LINUX
-    QGoodWindowUtils::m_gw_list.removeAll(this);
+#ifdef QGOODWINDOW
+    QGoodWindowUtils::m_gw_set.remove(this);
+
+    //Without windows no theme notification is received on Windows,
+    //query the theme again for the next window.
+    if (QGoodWindowUtils::m_gw_set.isEmpty())
+        QGoodWindowUtils::m_system_theme_known = false;
 #endif
 #ifdef Q_OS_MAC
     delete static_cast<macOSNative::Style*>(style_ptr);
@@ -559,8 +678,15 @@ QGoodWindow::~QGoodWindow()
 void QGoodWindow::themeChanged()
 {
 #ifdef QGOODWINDOW
-    bool dark = isSystemThemeDark();
+    themeChanged(isSystemThemeDark());
+#endif
+}
+
+void QGoodWindow::themeChanged(bool dark)
+{
+    QGOODWINDOW_TRACE_SCOPE("QGoodWindow::themeChanged");
 
+#ifdef QGOODWINDOW
     if (m_dark != dark)
     {
         m_dark = dark;
@@ -569,8 +695,20 @@ void QGoodWindow::themeChanged()
 #endif
 }
 
+void QGoodWindow::setVisible(bool visible)
+{
+#ifdef QGOODWINDOW
+    if (visible)
+        createNativeWindow();
+#endif
+    QMainWindow::setVisible(visible);
+}
+
 WId QGoodWindow::winId() const
 {
+#ifdef QGOODWINDOW
+    const_cast<QGoodWindow*>(this)->createNativeWindow();
+#endif
 #ifdef Q_OS_WIN
     return WId(m_hwnd);
 #else
@@ -794,6 +932,152 @@ int QGoodWindow::execDialog(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow
 #endif
 }
 
+QGoodWindowStats QGoodWindow::stats() const
+{
+    return m_stats;
+}
+
+void QGoodWindow::resetStats()
+{
+    m_stats.reset();
+}
+
+QGoodWindowStats QGoodWindow::processStats()
+{
+    return QGoodWindowStats::process();
+}
+
+void QGoodWindow::resetProcessStats()
+{
+    QGoodWindowStats::process().reset();
+}
+
+QVariantMap QGoodWindow::footprint() const
+{
+    QVariantMap map;
+
+    //A top level window has a backing store of it's size in device pixels
+    //with 32 bits per pixel while it's visible.
+    auto backing_store_bytes = [](const QWidget *widget){
+        if (!widget || !widget->isVisible())
+            return qint64(0);
+
+        const qreal pixel_ratio = widget->devicePixelRatioF();
+
+        return qint64(qCeil(widget->width() * pixel_ratio)) * qint64(qCeil(widget->height() * pixel_ratio)) * 4;
+    };
+
+    qint64 mask_bytes = regionBytes(mask());
+    int top_level_count = 1;
+    int timer_count = findChildren<QTimer*>().size();
+    qint64 shadow_backing_store_bytes = 0;
+
+#ifdef QGOODWINDOW
+    mask_bytes += regionBytes(m_title_bar_mask);
+    mask_bytes += regionBytes(m_min_mask);
+    mask_bytes += regionBytes(m_max_mask);
+    mask_bytes += regionBytes(m_cls_mask);
+
+#if defined Q_OS_WIN || defined Q_OS_LINUX
+    if (m_shadow && m_shadow->internalWinId())
+    {
+        top_level_count++;
+        timer_count += m_shadow->findChildren<QTimer*>().size();
+        mask_bytes += regionBytes(m_shadow->mask());
+        shadow_backing_store_bytes = backing_store_bytes(m_shadow);
+    }
+#endif
+#endif
+
+    map.insert("backing_store_bytes", backing_store_bytes(this));
+    map.insert("shadow_backing_store_bytes", shadow_backing_store_bytes);
+    map.insert("mask_bytes", mask_bytes);
+    map.insert("top_level_count", top_level_count);
+    map.insert("timer_count", timer_count);
+
+    return map;
+}
+
+qint64 QGoodWindow::pixmapBytes(const QPixmap &pixmap)
+{
+    if (pixmap.isNull())
+        return 0;
+
+    return qint64(pixmap.width()) * qint64(pixmap.height()) * qint64(pixmap.depth()) / 8;
+}
+
+qint64 QGoodWindow::regionBytes(const QRegion &region)
+{
+    return qint64(region.rectCount()) * qint64(sizeof(QRect));
+}
+
+void QGoodWindow::releaseCachedResources()
+{
+#ifdef QGOODWINDOW
+    if (isVisible() && !isMinimized())
+        return;
+
+#ifdef Q_OS_LINUX
+    //Set again by setMaskLinux() on show and on state change.
+    clearMask();
+
+    if (m_shadow)
+        m_shadow->releaseNativeWindow();
+#endif
+#ifdef QGOODCENTRALWIDGET
+    for (QGoodCentralWidget *gcw : findChildren<QGoodCentralWidget*>())
+    {
+        //Skip the central widgets of child windows.
+        if (gcw->window() == this)
+            gcw->releaseCachedResources();
+    }
+#endif
+#endif
+}
+
+void QGoodWindow::setAutoReleaseCachedResources(bool enabled)
+{
+#ifdef QGOODWINDOW
+    m_auto_release_cached_resources = enabled;
+
+    releaseCachedResourcesLater();
+#else
+    Q_UNUSED(enabled)
+#endif
+}
+
+bool QGoodWindow::autoReleaseCachedResources() const
+{
+#ifdef QGOODWINDOW
+    return m_auto_release_cached_resources;
+#else
+    return false;
+#endif
+}
+
+bool QGoodWindow::openDialog(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow *parent_gw)
+{
+#ifdef QGOODWINDOW
+    return QGoodDialog::open(dialog, child_gw, parent_gw);
+#else
+    Q_UNUSED(child_gw)
+
+    if (!dialog || !parent_gw)
+        return false;
+
+    QSharedPointer<QMetaObject::Connection> connection(new QMetaObject::Connection);
+
+    *connection = connect(dialog, &QDialog::finished, parent_gw, [=](int result){
+        disconnect(*connection);
+        Q_EMIT parent_gw->dialogFinished(dialog, result);
+    });
+
+    dialog->open();
+
+    return true;
+#endif
+}
+
 void QGoodWindow::setAppDarkTheme()
 {
     qApp->setStyle(new DarkStyle());
@@ -1437,6 +1721,10 @@ void QGoodWindow::activateWindow()
 void QGoodWindow::show()
 {
 #ifdef Q_OS_WIN
+    //ShowWindow() doesn't go through setVisible(),
+    //the shadow must exist before the window is shown.
+    createNativeWindow();
+
     if (!isVisible() && !m_window_state.testFlag(Qt::WindowNoState))
     {
         setWindowStateWin();
@@ -1452,6 +1740,8 @@ void QGoodWindow::show()
 void QGoodWindow::showNormal()
 {
 #ifdef Q_OS_WIN
+    createNativeWindow();
+
     if (isFullScreen())
     {
         m_window_state ^= Qt::WindowFullScreen;
@@ -1473,6 +1763,8 @@ void QGoodWindow::showMaximized()
         return;
 #endif
 #ifdef Q_OS_WIN
+    createNativeWindow();
+
     if (isFullScreen())
         showNormal();
 
@@ -1485,6 +1777,8 @@ void QGoodWindow::showMaximized()
 void QGoodWindow::showMinimized()
 {
 #ifdef Q_OS_WIN
+    createNativeWindow();
+
     if (isFullScreen())
         showNormal();
 
@@ -1501,6 +1795,8 @@ void QGoodWindow::showFullScreen()
         return;
 #endif
 #ifdef Q_OS_WIN
+    createNativeWindow();
+
     if (isFullScreen())
         return;
 
@@ -1657,6 +1953,9 @@ void QGoodWindow::setWindowState(Qt::WindowStates state)
 
 QWindow *QGoodWindow::windowHandle() const
 {
+#ifdef QGOODWINDOW
+    const_cast<QGoodWindow*>(this)->createNativeWindow();
+#endif
 #ifdef Q_OS_WIN
     return m_window_handle;
 #else
@@ -1837,6 +2136,38 @@ bool QGoodWindow::restoreGeometry(const QByteArray &geometry)
 
 bool QGoodWindow::event(QEvent *event)
 {
+#ifdef QGOODWINDOW
+    switch (event->type())
+    {
+    case QEvent::Show:
+    case QEvent::Hide:
+    case QEvent::WindowStateChange:
+    {
+        releaseCachedResourcesLater();
+        break;
+    }
+    case QEvent::StyleChange:
+    case QEvent::ThemeChange:
+    {
+        //Follow the style and the icon theme while the default icon is in use,
+        //the first window to get the event loads the new icon for all of them.
+        if (m_default_icon_key == 0 || windowIcon().cacheKey() != m_default_icon_key)
+            break;
+
+        const QIcon icon = QGoodWindowUtils::defaultWindowIcon();
+
+        if (icon.cacheKey() != m_default_icon_key)
+        {
+            m_default_icon_key = icon.cacheKey();
+            setWindowIcon(icon);
+        }
+
+        break;
+    }
+    default:
+        break;
+    }
+#endif
 #if defined Q_OS_LINUX || defined Q_OS_MAC
     switch (event->type())
     {
@@ -1968,6 +2299,9 @@ bool QGoodWindow::event(QEvent *event)
     case QEvent::Resize:
     case QEvent::Move:
     {
+        if (!m_shadow)
+            break;
+
         if (isVisible() && windowState().testFlag(Qt::WindowNoState))
         {
             sizeMoveBorders();
@@ -1992,7 +2326,8 @@ bool QGoodWindow::event(QEvent *event)
         if (!windowState().testFlag(Qt::WindowNoState))
             break;
 
-        m_shadow->hide();
+        if (m_shadow)
+            m_shadow->hide();
 
         break;
     }
@@ -2006,7 +2341,8 @@ bool QGoodWindow::event(QEvent *event)
         if (!windowState().testFlag(Qt::WindowNoState))
             break;
 
-        m_shadow->show();
+        if (m_shadow)
+            m_shadow->show();
 
         break;
     }
@@ -2807,6 +3143,8 @@ void QGoodWindow::closeGW()
 
 void QGoodWindow::setWindowStateWin()
 {
+    createNativeWindow();
+
     if (m_window_state.testFlag(Qt::WindowFullScreen))
         showFullScreen();
     else if (m_window_state.testFlag(Qt::WindowMaximized))
@@ -3438,7 +3776,9 @@ LRESULT QGoodWindow::WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lPar
         {
             if (QString::fromWCharArray(LPCWSTR(lParam)) == "ImmersiveColorSet")
             {
-                QTimer::singleShot(0, gw, &QGoodWindow::themeChanged);
+                //Every top level window receives the message,
+                //the change is applied to all windows only once.
+                QGoodWindowUtils::themeChangeLater();
             }
         }
 
@@ -3453,23 +3793,20 @@ LRESULT QGoodWindow::WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lPar
         //Windows composition modes or system themes.
         SendMessageW(HWND(gw->m_helper_widget->winId()), message, 0, 0);
 
-        if (QtWin::isCompositionEnabled())
-        {
-            QTimer::singleShot(100, gw, [=]{
+        //Both messages are often sent together, the window is refreshed once.
+        QGoodScheduler::schedule(gw, QGoodScheduler::Task::CompositionChange, 100, [=]{
+            if (QtWin::isCompositionEnabled())
+            {
                 gw->enableCaption();
                 gw->frameChanged();
                 SetWindowRgn(hwnd, nullptr, TRUE);
-            });
-        }
-        else
-        {
-            QTimer::singleShot(100, gw, [=]{
+            }
+            else
+            {
                 gw->disableCaption();
                 gw->frameChanged();
-            });
-        }
+            }
 
-        QTimer::singleShot(100, gw, [=]{
             gw->sizeMoveWindow();
             gw->repaint();
         });
@@ -3791,7 +4128,7 @@ void QGoodWindow::updateScreen(QScreen *screen)
 
 void QGoodWindow::setCurrentScreen(QScreen *screen)
 {
-    windowHandle()->setScreen(screen);
+    m_window_handle->setScreen(screen);
 
     m_main_window->windowHandle()->setScreen(screen);
 
@@ -4111,6 +4448,8 @@ void QGoodWindow::iconClicked()
 #ifdef Q_OS_LINUX
 void QGoodWindow::setCursorForCurrentPos()
 {
+    QGOODWINDOW_TRACE_SCOPE("QGoodWindow::setCursorForCurrentPos");
+
     const QPoint cursor_pos = QCursor::pos();
     const int margin = int(ncHitTest(qFloor(cursor_pos.x() * m_pixel_ratio), qFloor(cursor_pos.y() * m_pixel_ratio)));
 
@@ -4131,6 +4470,8 @@ void QGoodWindow::setCursorForCurrentPos()
     {
     case HTTOPLEFT:
     {
+        QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::CursorDefine);
+
         Cursor cursor;
 
         if (!FIXED_SIZE(this))
@@ -4148,6 +4489,8 @@ void QGoodWindow::setCursorForCurrentPos()
     }
     case HTTOP:
     {
+        QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::CursorDefine);
+
         Cursor cursor;
 
         if (!FIXED_HEIGHT(this))
@@ -4165,6 +4508,8 @@ void QGoodWindow::setCursorForCurrentPos()
     }
     case HTTOPRIGHT:
     {
+        QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::CursorDefine);
+
         Cursor cursor;
 
         if (!FIXED_SIZE(this))
@@ -4182,6 +4527,8 @@ void QGoodWindow::setCursorForCurrentPos()
     }
     case HTLEFT:
     {
+        QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::CursorDefine);
+
         Cursor cursor;
 
         if (!FIXED_WIDTH(this))
@@ -4199,6 +4546,8 @@ void QGoodWindow::setCursorForCurrentPos()
     }
     case HTRIGHT:
     {
+        QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::CursorDefine);
+
         Cursor cursor;
 
         if (!FIXED_WIDTH(this))
@@ -4216,6 +4565,8 @@ void QGoodWindow::setCursorForCurrentPos()
     }
     case HTBOTTOMLEFT:
     {
+        QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::CursorDefine);
+
         Cursor cursor;
 
         if (!FIXED_SIZE(this))
@@ -4233,6 +4584,8 @@ void QGoodWindow::setCursorForCurrentPos()
     }
     case HTBOTTOM:
     {
+        QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::CursorDefine);
+
         Cursor cursor;
 
         if (!FIXED_HEIGHT(this))
@@ -4250,6 +4603,8 @@ void QGoodWindow::setCursorForCurrentPos()
     }
     case HTBOTTOMRIGHT:
     {
+        QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::CursorDefine);
+
         Cursor cursor;
 
         if (!FIXED_SIZE(this))
@@ -4297,6 +4652,8 @@ void QGoodWindow::setCursorForCurrentPos()
 
 void QGoodWindow::startSystemMoveResize()
 {
+    QGOODWINDOW_TRACE_SCOPE("QGoodWindow::startSystemMoveResize");
+
     const int margin = m_margin;
 
     if (margin == HTNOWHERE)
@@ -4325,6 +4682,8 @@ void QGoodWindow::startSystemMoveResize()
     xmsg.data.l[3] = 0;
     xmsg.data.l[4] = 0;
 
+    QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::ClientMessage);
+
     XSendEvent(QX11Info::display(), QX11Info::appRootWindow(), False,
                SubstructureRedirectMask | SubstructureNotifyMask,
                reinterpret_cast<XEvent*>(&xmsg));
@@ -4360,6 +4719,11 @@ void QGoodWindow::sizeMove()
 
 void QGoodWindow::sizeMoveBorders()
 {
+    QGOODWINDOW_TRACE_SCOPE("QGoodWindow::sizeMoveBorders");
+
+    if (!m_shadow)
+        return;
+
     if (!windowState().testFlag(Qt::WindowNoState))
         return;
 
@@ -4384,6 +4748,8 @@ void QGoodWindow::sizeMoveBorders()
 
     rgn.translate(-rgn.boundingRect().topLeft());
 
+    QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::ShapeUpdate);
+
     m_shadow->setMask(rgn);
 
     m_shadow->setGeometry(frame_geom);
@@ -4391,6 +4757,10 @@ void QGoodWindow::sizeMoveBorders()
 
 void QGoodWindow::setMaskLinux()
 {
+    QGOODWINDOW_TRACE_SCOPE("QGoodWindow::setMaskLinux");
+
+    QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::MaskRebuild);
+
     QRegion mask = rect();
 
     if (isVisible() && windowState().testFlag(Qt::WindowNoState))
@@ -4412,6 +4782,8 @@ void QGoodWindow::setMaskLinux()
         mask = bmp;
     }
 
+    QGoodWindowStats::Scope shape_stats_scope(this, QGoodWindowStats::Counter::ShapeUpdate);
+
     setMask(mask);
 }
 #endif
@@ -4443,7 +4815,7 @@ void QGoodWindow::notificationReceiver(const QByteArray &notification)
     }
     else if (notification == "AppleInterfaceThemeChangedNotification")
     {
-        QTimer::singleShot(0, this, &QGoodWindow::themeChanged);
+        QGoodWindowUtils::themeChangeLater();
     }
 }
 #endif
@@ -4451,6 +4823,10 @@ void QGoodWindow::notificationReceiver(const QByteArray &notification)
 #ifdef QGOODWINDOW
 qintptr QGoodWindow::ncHitTest(int pos_x, int pos_y)
 {
+    QGOODWINDOW_TRACE_SCOPE("QGoodWindow::ncHitTest");
+
+    QGoodWindowStats::Scope stats_scope(this, QGoodWindowStats::Counter::HitTest);
+
     if (isFullScreen())
     {
         //If on full screen, the whole window can be clicked.
@@ -4684,6 +5060,76 @@ bool QGoodWindow::buttonPress(qintptr button)
     return false;
 }
 
+void QGoodWindow::createNativeWindow()
+{
+    if (m_native_window_created)
+        return;
+
+    m_native_window_created = true;
+
+    QGOODWINDOW_TRACE_SCOPE("QGoodWindow::createNativeWindow");
+
+#ifdef Q_OS_WIN
+    //The HWND is the window itself and is created by the constructor,
+    //only the shadow is left for the first show.
+    if (!m_is_using_system_borders)
+    {
+        QGoodWindow *parent = m_parent ? this : nullptr;
+        m_shadow = new Shadow(qintptr(m_hwnd), parent, parent);
+        m_shadow->createWinId();
+        m_shadow->windowHandle()->setScreen(m_window_handle->screen());
+        connect(m_shadow, &Shadow::showSignal, this, &QGoodWindow::moveShadow);
+
+        if (GetWindowLongW(m_hwnd, GWL_EXSTYLE) & WS_EX_TOPMOST)
+            SetWindowPos(HWND(m_shadow->winId()), HWND_TOPMOST, 0, 0, 0, 0, SWP_NOSIZE | SWP_NOMOVE | SWP_NOACTIVATE);
+    }
+#endif
+#ifdef Q_OS_LINUX
+    QMainWindow::createWinId();
+
+    m_pixel_ratio = QMainWindow::windowHandle()->screen()->devicePixelRatio();
+
+    QGoodWindowUtils::registerThemeChangeNotification();
+
+    m_shadow = new Shadow(qintptr(nullptr), this, this);
+    m_shadow->installEventFilter(this);
+    m_shadow->setMouseTracking(true);
+    connect(m_shadow, &Shadow::showSignal, this, &QGoodWindow::sizeMoveBorders);
+#endif
+#ifdef Q_OS_MAC
+    QMainWindow::createWinId();
+
+    if (!QGoodWindowUtils::m_theme_change_registered)
+    {
+        QGoodWindowUtils::m_theme_change_registered = true;
+        macOSNative::registerThemeChangeNotification();
+
+        //Changes made before the registration were missed.
+        QGoodWindowUtils::m_system_theme_known = false;
+    }
+#endif
+#if defined Q_OS_LINUX || defined Q_OS_MAC
+    //Catch up with the theme known by the process, it's only
+    //queried again if the notifications were just registered.
+    themeChanged(QGoodWindowUtils::systemThemeDark());
+#endif
+}
+
+void QGoodWindow::releaseCachedResourcesLater()
+{
+    //Wait a little, so quickly hiding and showing or minimizing
+    //and restoring the window doesn't rebuild everything.
+    if (m_auto_release_cached_resources && (!isVisible() || isMinimized()))
+    {
+        QGoodScheduler::schedule(this, QGoodScheduler::Task::ReleaseResources, 3000,
+                                 [=]{releaseCachedResources();});
+    }
+    else
+    {
+        QGoodScheduler::cancel(this, QGoodScheduler::Task::ReleaseResources);
+    }
+}
+
 bool QGoodWindow::buttonRelease(qintptr button, bool valid_click)
 {
     if (button == -1)
@@ -4692,7 +5138,8 @@ bool QGoodWindow::buttonRelease(qintptr button, bool valid_click)
     if (!m_is_caption_button_pressed)
         return false;
 
-    if (m_hover_timer->isActive())
+    //Ignore releases for a short time after a click.
+    if (m_hover_timer.isValid() && m_hover_timer.elapsed() < 300)
         return false;
 
     m_is_caption_button_pressed = false;
@@ -4708,7 +5155,7 @@ bool QGoodWindow::buttonRelease(qintptr button, bool valid_click)
         {
             buttonLeave(button);
             Q_EMIT captionButtonStateChanged(CaptionButtonState::MinimizeClicked);
-            m_hover_timer->start();
+            m_hover_timer.start();
         }
 
         return true;
@@ -4721,7 +5168,7 @@ bool QGoodWindow::buttonRelease(qintptr button, bool valid_click)
         {
             buttonLeave(button);
             Q_EMIT captionButtonStateChanged(CaptionButtonState::MaximizeClicked);
-            m_hover_timer->start();
+            m_hover_timer.start();
         }
 
         return true;
@@ -4734,7 +5181,7 @@ bool QGoodWindow::buttonRelease(qintptr button, bool valid_click)
         {
             buttonLeave(button);
             Q_EMIT captionButtonStateChanged(CaptionButtonState::CloseClicked);
-            m_hover_timer->start();
+            m_hover_timer.start();
         }
 
         return true;
@@ -30,6 +30,8 @@ SOFTWARE.
 #include <QtWidgets>
 #include "intcommon.h"
 #include "qgoodstateholder.h"
+#include "qgoodtrace.h"
+#include "qgoodwindowstats.h"
 #include "lightstyle.h"
 #include "darkstyle.h"
 
@@ -126,9 +128,11 @@ public:
     //Functions
     //\cond HIDDEN_SYMBOLS
     void themeChanged();
+    void themeChanged(bool dark);
+    void setVisible(bool visible) override;
     //\endcond
 
-    /** Returns the window id of the *QGoodWindow*. */
+    /** Returns the window id of the *QGoodWindow*, the native window is created on the first call or show. */
     WId winId() const;
 
     /** *QGoodWindow* handles flags internally, but this function could be used to create a always on top window. */
@@ -157,6 +161,12 @@ public:
     /** Show modal frame less *QDialog*, inside window \e child_gw, with parent \e parent_gw. */
     static int execDialog(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow *parent_gw);
 
+    /** Show modal frame less *QDialog*, inside window \e child_gw, with parent \e parent_gw and return immediately
+        without a nested event loop. The result is reported by the *dialogFinished* SIGNAL of \e parent_gw.
+        Dialogs opened while other dialogs are open are stacked on top of them.
+        Returns false if the dialog could not be opened. */
+    static bool openDialog(QDialog *dialog, QGoodWindow *child_gw, QGoodWindow *parent_gw);
+
     /** Set the app theme to the dark theme. */
     static void setAppDarkTheme();
 
@@ -166,6 +176,42 @@ public:
     /** Get the global state holder. */
     static QGoodStateHolder *qGoodStateHolderInstance();
 
+    /** Returns the work done by this window since it's creation or the last *resetStats* call. */
+    QGoodWindowStats stats() const;
+
+    /** Sets the counters of this window to zero. */
+    void resetStats();
+
+    /** Returns the work done by all windows of the process since it's start or the last *resetProcessStats* call. */
+    static QGoodWindowStats processStats();
+
+    /** Sets the process wide counters to zero. */
+    static void resetProcessStats();
+
+    /** Returns an estimate of the client side memory held by this window, in bytes: "backing_store_bytes"
+        of the window, "shadow_backing_store_bytes" of the shadow window, "mask_bytes" of the masks,
+        and the number of top level windows in "top_level_count" and of timers in "timer_count".
+        Add *QGoodCentralWidget::footprint* for the title bar. */
+    QVariantMap footprint() const;
+
+    /** Returns the bytes used by the pixels of \e pixmap. */
+    static qint64 pixmapBytes(const QPixmap &pixmap);
+
+    /** Returns the bytes used by the rects of \e region. */
+    static qint64 regionBytes(const QRegion &region);
+
+    /** Releases the state that is rebuilt when the window is shown again: the native shadow window
+        and the window mask on Linux, and the masks and pixmaps of *QGoodCentralWidget*.
+        Has no effect while the window is visible and not minimized. */
+    void releaseCachedResources();
+
+    /** Set if *releaseCachedResources* is called automatically a few seconds after the window is hidden
+        or minimized to \e enabled, the default is enabled. */
+    void setAutoReleaseCachedResources(bool enabled);
+
+    /** Returns if *releaseCachedResources* is called automatically for hidden and minimized windows. */
+    bool autoReleaseCachedResources() const;
+
     /*** QGOODWINDOW FUNCTIONS END ***/
 Q_SIGNALS:
     /** On handled caption buttons, this SIGNAL report the state of these buttons. */
@@ -177,6 +223,9 @@ Q_SIGNALS:
     /** Notify that the visibility of caption buttons have changed on macOS. */
     void captionButtonsVisibilityChangedOnMacOS();
 
+    /** Notify that a \e dialog opened with *openDialog* with this window as parent finished with \e result. */
+    void dialogFinished(QDialog *dialog, int result);
+
     /*** QGOODWINDOW FUNCTIONS BEGIN ***/
 public Q_SLOTS:
     /** Set native dark mode on Windows to \e dark. **/
@@ -550,10 +599,20 @@ private:
     bool buttonPress(qintptr button);
     bool buttonRelease(qintptr button, bool valid_click);
 
+    void releaseCachedResourcesLater();
+
+    void createNativeWindow();
+
     //Variables
     QPointer<QWidget> m_parent;
 
-    QPointer<QTimer> m_hover_timer;
+    bool m_native_window_created;
+
+    bool m_auto_release_cached_resources;
+
+    qint64 m_default_icon_key;
+
+    QElapsedTimer m_hover_timer;
 
     QRegion m_title_bar_mask;
 
@@ -574,6 +633,10 @@ private:
     qintptr m_last_caption_button_hovered;
     qintptr m_caption_button_pressed;
 #endif
+    //Variables
+    QGoodWindowStats m_stats;
+
+    friend class QGoodWindowStats::Scope;
     //\endcond
 };
 
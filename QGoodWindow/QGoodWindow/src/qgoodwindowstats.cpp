@@ -0,0 +1,143 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "qgoodwindowstats.h"
+#include "qgoodwindow.h"
+
+QGoodWindowStats::QGoodWindowStats()
+{
+    reset();
+}
+
+quint64 QGoodWindowStats::count(Counter counter) const
+{
+    return m_count[int(counter)];
+}
+
+qint64 QGoodWindowStats::nsecs(Counter counter) const
+{
+    return m_nsecs[int(counter)];
+}
+
+quint64 QGoodWindowStats::xRequestCount() const
+{
+    return count(Counter::CursorDefine) + count(Counter::ShapeUpdate) + count(Counter::ClientMessage);
+}
+
+double QGoodWindowStats::schedulerWakeupsPerSecond() const
+{
+    const qint64 msecs = m_clock.elapsed();
+
+    if (msecs <= 0)
+        return 0;
+
+    return double(count(Counter::TimerWakeup)) * 1000.0 / double(msecs);
+}
+
+void QGoodWindowStats::reset()
+{
+    for (int i = 0; i < CounterCount; i++)
+    {
+        m_count[i] = 0;
+        m_nsecs[i] = 0;
+    }
+
+    m_clock.start();
+}
+
+QString QGoodWindowStats::counterName(Counter counter)
+{
+    switch (counter)
+    {
+    case Counter::HitTest:
+        return QStringLiteral("hit_test");
+    case Counter::CursorDefine:
+        return QStringLiteral("cursor_define");
+    case Counter::ShapeUpdate:
+        return QStringLiteral("shape_update");
+    case Counter::ClientMessage:
+        return QStringLiteral("client_message");
+    case Counter::MaskRebuild:
+        return QStringLiteral("mask_rebuild");
+    case Counter::StyleSheetApply:
+        return QStringLiteral("style_sheet_apply");
+    case Counter::IconRasterization:
+        return QStringLiteral("icon_rasterization");
+    case Counter::ShadowShowHide:
+        return QStringLiteral("shadow_show_hide");
+    case Counter::UpdatePass:
+        return QStringLiteral("update_pass");
+    case Counter::TimerWakeup:
+        return QStringLiteral("timer_wakeup");
+    }
+
+    return QString();
+}
+
+QVariantMap QGoodWindowStats::toVariantMap() const
+{
+    QVariantMap map;
+
+    for (int i = 0; i < CounterCount; i++)
+    {
+        QVariantMap counter_map;
+        counter_map.insert(QStringLiteral("count"), m_count[i]);
+        counter_map.insert(QStringLiteral("nsecs"), m_nsecs[i]);
+
+        map.insert(counterName(Counter(i)), counter_map);
+    }
+
+    map.insert(QStringLiteral("scheduler_wakeups_per_second"), schedulerWakeupsPerSecond());
+
+    return map;
+}
+
+void QGoodWindowStats::add(Counter counter, qint64 nsecs)
+{
+    m_count[int(counter)]++;
+    m_nsecs[int(counter)] += nsecs;
+}
+
+QGoodWindowStats &QGoodWindowStats::process()
+{
+    static QGoodWindowStats stats;
+    return stats;
+}
+
+QGoodWindowStats::Scope::Scope(QGoodWindow *gw, Counter counter)
+{
+    m_gw = gw;
+    m_counter = counter;
+    m_timer.start();
+}
+
+QGoodWindowStats::Scope::~Scope()
+{
+    const qint64 nsecs = m_timer.nsecsElapsed();
+
+    process().add(m_counter, nsecs);
+
+    if (m_gw)
+        m_gw->m_stats.add(m_counter, nsecs);
+}
@@ -0,0 +1,131 @@
+/*
+The MIT License (MIT)
+
+Copyright © 2018-2024 Antonio Dias (https://github.com/antonypro)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef QGOODWINDOWSTATS_H
+#define QGOODWINDOWSTATS_H
+
+#include <QtCore>
+
+#include "qgoodwindow_global.h"
+
+class QGoodWindow;
+
+/** **QGoodWindowStats** counts the work done by *QGoodWindow* and *QGoodCentralWidget*,
+ * with the cumulative time spent on each kind of work. */
+class QGOODWINDOW_SHARED_EXPORT QGoodWindowStats
+{
+public:
+    /** Kinds of work counted. */
+    enum class Counter
+    {
+        /** Hit tests of the window borders and title bar. */
+        HitTest,
+
+        /** Cursor defines sent to the X server. */
+        CursorDefine,
+
+        /** Shape updates of the window or it's resize borders. */
+        ShapeUpdate,
+
+        /** Client messages sent to the window manager. */
+        ClientMessage,
+
+        /** Rebuilds of the window mask or the title bar mask. */
+        MaskRebuild,
+
+        /** Style sheet applications of the light and dark styles. */
+        StyleSheetApply,
+
+        /** Rasterizations of the window icon and the caption button icons. */
+        IconRasterization,
+
+        /** Shadow shows and hides. */
+        ShadowShowHide,
+
+        /** Update passes of *QGoodCentralWidget*. */
+        UpdatePass,
+
+        /** Wakeups of the timer shared by the deferred work of all windows, only counted process wide. */
+        TimerWakeup
+    };
+
+    /** Number of values of *Counter*. */
+    static const int CounterCount = int(Counter::TimerWakeup) + 1;
+
+    /** Constructor of *QGoodWindowStats*, all counters are zero. */
+    QGoodWindowStats();
+
+    /** Number of times the \e counter work was done. */
+    quint64 count(Counter counter) const;
+
+    /** Cumulative time in nanoseconds spent on the \e counter work. */
+    qint64 nsecs(Counter counter) const;
+
+    /** Number of requests sent to the X server, the sum of cursor defines, shape updates and client messages. */
+    quint64 xRequestCount() const;
+
+    /** Average number of wakeups per second of the timer that runs the deferred work of all windows,
+        since construction or the last *reset* call. Other timers of the library and of Qt are not counted,
+        so this is not the idle wakeup rate of the process. */
+    double schedulerWakeupsPerSecond() const;
+
+    /** Sets all counters to zero. */
+    void reset();
+
+    /** Name of \e counter. */
+    static QString counterName(Counter counter);
+
+    /** All counters as a map of name to a map with "count" and "nsecs", and the "scheduler_wakeups_per_second" value. */
+    QVariantMap toVariantMap() const;
+
+    //\cond HIDDEN_SYMBOLS
+    //Adds the time spent since construction to the counter of the window, if any,
+    //and to the process wide counter.
+    class QGOODWINDOW_SHARED_EXPORT Scope
+    {
+    public:
+        explicit Scope(QGoodWindow *gw, Counter counter);
+        ~Scope();
+
+    private:
+        QGoodWindow *m_gw;
+        Counter m_counter;
+        QElapsedTimer m_timer;
+
+        Q_DISABLE_COPY(Scope)
+    };
+
+    void add(Counter counter, qint64 nsecs);
+
+    static QGoodWindowStats &process();
+    //\endcond
+
+private:
+    //Variables
+    quint64 m_count[CounterCount];
+    qint64 m_nsecs[CounterCount];
+    QElapsedTimer m_clock;
+};
+
+#endif // QGOODWINDOWSTATS_H
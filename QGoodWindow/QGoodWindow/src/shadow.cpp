@@ -25,6 +25,7 @@ SOFTWARE.
 #include "common.h"
 #include "shadow.h"
 #include "qgoodwindow.h"
+#include "qgoodscheduler.h"
 
 #ifdef Q_OS_WIN
 #define SHADOWWIDTH 10
@@ -33,6 +34,11 @@ SOFTWARE.
 #define COLOR3 QColor(0, 0, 0, 1)
 #endif
 
+#if defined Q_OS_WIN || defined Q_OS_LINUX
+//Time to wait before showing shadow when showLater() is callled.
+#define SHOW_DELAY 500
+#endif
+
 Shadow::Shadow(qintptr hwnd, QGoodWindow *gw, QWidget *parent) : QWidget(parent)
 {
 #ifdef Q_OS_WIN
@@ -57,16 +63,41 @@ Shadow::Shadow(qintptr hwnd, QGoodWindow *gw, QWidget *parent) : QWidget(parent)
     setAttribute(Qt::WA_TranslucentBackground);
 #endif
 #if defined Q_OS_WIN || defined Q_OS_LINUX
-    m_timer = new QTimer(this);
-    connect(m_timer, &QTimer::timeout, this, &Shadow::show);
-    //Time to wait before showing shadow when showLater() is callled.
-    m_timer->setInterval(500);
-    m_timer->setSingleShot(true);
-
     setWindowTitle("Shadow");
 #endif
 }
 
+Shadow::~Shadow()
+{
+#if defined Q_OS_WIN || defined Q_OS_LINUX
+    QGoodScheduler::cancel(this, QGoodScheduler::Task::ShadowShow);
+#endif
+}
+
+bool Shadow::isShowPending()
+{
+#if defined Q_OS_WIN || defined Q_OS_LINUX
+    return QGoodScheduler::isScheduled(this, QGoodScheduler::Task::ShadowShow);
+#else
+    return false;
+#endif
+}
+
+void Shadow::releaseNativeWindow()
+{
+#ifdef Q_OS_LINUX
+    //The native window is created again on the next show,
+    //and the mask is set again just before it.
+    if (isVisible() || !testAttribute(Qt::WA_WState_Created))
+        return;
+
+    QGoodScheduler::cancel(this, QGoodScheduler::Task::ShadowShow);
+
+    clearMask();
+    destroy();
+#endif
+}
+
 int Shadow::shadowWidth()
 {
 #ifdef Q_OS_WIN
@@ -79,15 +110,15 @@ int Shadow::shadowWidth()
 void Shadow::showLater()
 {
 #if defined Q_OS_WIN || defined Q_OS_LINUX
-    m_timer->stop();
-    m_timer->start();
+    //Scheduling again moves the deadline, as moves and resizes keep coming.
+    QGoodScheduler::schedule(this, QGoodScheduler::Task::ShadowShow, SHOW_DELAY, [=]{show();});
 #endif
 }
 
 void Shadow::show()
 {
 #ifdef Q_OS_WIN
-    if (m_timer->isActive())
+    if (isShowPending())
         return;
 
     if (!IsWindowEnabled(m_hwnd))
@@ -98,13 +129,15 @@ void Shadow::show()
 
     Q_EMIT showSignal();
 
+    QGoodWindowStats::Scope stats_scope(m_parent, QGoodWindowStats::Counter::ShadowShowHide);
+
     QWidget::show();
     QWidget::raise();
 
     SetWindowPos(m_hwnd, HWND_TOP, 0, 0, 0, 0, SWP_NOSIZE | SWP_NOMOVE | SWP_NOACTIVATE);
 #endif
 #ifdef Q_OS_LINUX
-    if (m_timer->isActive())
+    if (isShowPending())
         return;
 
     QWidget *modal_widget = qApp->activeModalWidget();
@@ -115,6 +148,8 @@ void Shadow::show()
         {
             Q_EMIT showSignal();
 
+            QGoodWindowStats::Scope stats_scope(m_parent, QGoodWindowStats::Counter::ShadowShowHide);
+
             QWidget::show();
             QWidget::raise();
         }
@@ -125,7 +160,7 @@ void Shadow::show()
 void Shadow::hide()
 {
 #ifdef Q_OS_WIN
-    m_timer->stop();
+    QGoodScheduler::cancel(this, QGoodScheduler::Task::ShadowShow);
 
     if (m_parent && m_parent->windowState().testFlag(Qt::WindowNoState))
         return;
@@ -133,14 +168,18 @@ void Shadow::hide()
     if (!isVisible())
         return;
 
+    QGoodWindowStats::Scope stats_scope(m_parent, QGoodWindowStats::Counter::ShadowShowHide);
+
     QWidget::hide();
 #endif
 #ifdef Q_OS_LINUX
-    m_timer->stop();
+    QGoodScheduler::cancel(this, QGoodScheduler::Task::ShadowShow);
 
     if (m_parent->isMinimized() || !m_parent->isVisible())
         return;
 
+    QGoodWindowStats::Scope stats_scope(m_parent, QGoodWindowStats::Counter::ShadowShowHide);
+
     QWidget::hide();
 #endif
 }
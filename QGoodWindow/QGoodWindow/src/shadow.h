@@ -40,6 +40,7 @@ class Shadow : public QWidget
     Q_OBJECT
 public:
     explicit Shadow(qintptr hwnd, QGoodWindow *gw, QWidget *parent);
+    ~Shadow();
 
 Q_SIGNALS:
     void showSignal();
@@ -50,9 +51,11 @@ public Q_SLOTS:
     void hide();
     void setActive(bool active);
     int shadowWidth();
+    void releaseNativeWindow();
 
 private:
     //Functions
+    bool isShowPending();
     bool nativeEvent(const QByteArray &eventType, void *message, qgoodintptr *result);
     bool event(QEvent *event);
     void paintEvent(QPaintEvent *event);
@@ -60,7 +63,6 @@ private:
     //Variables
 #if defined Q_OS_WIN || defined Q_OS_LINUX
     QPointer<QGoodWindow> m_parent;
-    QPointer<QTimer> m_timer;
 #endif
 #ifdef Q_OS_WIN
     HWND m_hwnd;
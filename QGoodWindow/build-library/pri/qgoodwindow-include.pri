@@ -37,6 +37,12 @@ $$shell_path($$PWD/../../QGoodWindow/src/darkstyle.h) $$shell_path($$HEADER_DEST
 copygoodheader7.commands += $$QMAKE_COPY \
 $$shell_path($$PWD/../../QGoodWindow/lib-helper/qgoodwindow_helper.h) $$shell_path($$HEADER_DESTINATION/src)
 
+copygoodheader9.commands += $$QMAKE_COPY \
+$$shell_path($$PWD/../../QGoodWindow/src/qgoodtrace.h) $$shell_path($$HEADER_DESTINATION/src)
+
+copygoodheader10.commands += $$QMAKE_COPY \
+$$shell_path($$PWD/../../QGoodWindow/src/qgoodwindowstats.h) $$shell_path($$HEADER_DESTINATION/src)
+
 plugin {
 copygoodheader8.commands += $$QMAKE_COPY \
 $$shell_path($$PWD/../../QGoodWindow/lib-helper/qgoodwindow_global.h) $$shell_path($$HEADER_DESTINATION/src)
@@ -53,7 +59,9 @@ copygoodheader4 \
 copygoodheader5 \
 copygoodheader6 \
 copygoodheader7 \
-copygoodheader8
+copygoodheader8 \
+copygoodheader9 \
+copygoodheader10
 
 export(copygoodheader1.commands)
 export(copygoodheader2.commands)
@@ -62,6 +70,8 @@ export(copygoodheader4.commands)
 export(copygoodheader6.commands)
 export(copygoodheader7.commands)
 export(copygoodheader8.commands)
+export(copygoodheader9.commands)
+export(copygoodheader10.commands)
 
 QMAKE_EXTRA_TARGETS += \
 copygoodheader1 \
@@ -71,4 +81,6 @@ copygoodheader4 \
 copygoodheader5 \
 copygoodheader6 \
 copygoodheader7 \
-copygoodheader8
+copygoodheader8 \
+copygoodheader9 \
+copygoodheader10